@@ -0,0 +1,65 @@
+// swift-tools-version:5.9
+//
+//  Package.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import PackageDescription
+
+// The sources of the sample which do not depend on UIKit nor on the SDK are also built as a Swift package, so their
+// tests and benchmarks can run on any platform, Linux included:
+//
+//     swift test
+//     swift test -c release --filter VideoHeaderAdBenchmarks
+//
+// The app itself (and the tests depending on the SDK) are built with the Xcode workspace.
+let package = Package(
+    name: "VideoHeaderAdSample",
+    targets: [
+        .target(
+            name: "VideoHeaderAdCore",
+            path: "VideoHeaderAdSample",
+            exclude: [
+                "AppDelegate",
+                "Misc",
+                "Pods",
+                "Podfile",
+                "Podfile.lock",
+                "SASAllocationCounter",
+                "SASVideoHeaderAdCell.xib",
+                "VideoHeaderAdBenchmarks",
+                "VideoHeaderAdSample.xcodeproj",
+                "VideoHeaderAdSample.xcworkspace",
+                "VideoHeaderAdSampleTests",
+                "ViewControllers",
+            ],
+            sources: [
+                "SASAdPrice.swift",
+                "SASAdServerSimulator.swift",
+                "SASVideoHeaderAdLayout.swift",
+                "SeededRandomNumberGenerator.swift",
+            ]
+        ),
+        .target(
+            name: "SASAllocationCounter",
+            path: "VideoHeaderAdSample/SASAllocationCounter"
+        ),
+        .testTarget(
+            name: "VideoHeaderAdCoreTests",
+            dependencies: ["VideoHeaderAdCore"],
+            path: "VideoHeaderAdSample/VideoHeaderAdSampleTests",
+            sources: [
+                "SASAdPriceTests.swift",
+                "SASAdServerSimulatorTests.swift",
+                "SASVideoHeaderAdLayoutTests.swift",
+            ]
+        ),
+        .testTarget(
+            name: "VideoHeaderAdBenchmarks",
+            dependencies: ["VideoHeaderAdCore", "SASAllocationCounter"],
+            path: "VideoHeaderAdSample/VideoHeaderAdBenchmarks"
+        ),
+    ]
+)
@@ -0,0 +1,139 @@
+//
+//  SASAdAsyncLoading.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import UIKit
+import SASDisplayKit
+
+/**
+ Bridge between a completion based ad load and a Swift concurrency task awaiting it.
+ 
+ The awaiting task is resumed exactly once: with the result of the load, or with a `CancellationError` if the task
+ is cancelled first, in which case the given cancellation block tears the load down.
+ 
+ @note This class must only be used from the main thread (the cancellation of the task is forwarded to it).
+ */
+final class SASAdLoadContinuation<Value>: @unchecked Sendable {
+    
+    // MARK: - Private properties
+    
+    private var continuation: CheckedContinuation<Value, any Error>? = nil
+    private var cancellation: (() -> Void)? = nil
+    private var isCancelled = false
+    
+    // MARK: - Public API
+    
+    /**
+     Starts a load and suspends the current task until its result is delivered.
+     
+     @param start The block starting the load, called on the main thread unless the task is already cancelled.
+     @param cancellation The block tearing the load down if the task is cancelled before its result is delivered.
+     @return The result of the load.
+     */
+    @MainActor
+    func perform(_ start: () -> Void, cancellation: @escaping () -> Void) async throws -> Value {
+        return try await withTaskCancellationHandler {
+            try await withCheckedThrowingContinuation { continuation in
+                guard !isCancelled, !Task.isCancelled else {
+                    continuation.resume(throwing: CancellationError())
+                    return
+                }
+                self.continuation = continuation
+                self.cancellation = cancellation
+                start()
+            }
+        } onCancel: {
+            // The cancellation handler can be called from any thread, the load being torn down on the main thread.
+            DispatchQueue.main.async {
+                self.cancel()
+            }
+        }
+    }
+    
+    /// Whether the load is still awaited.
+    var isPending: Bool {
+        return continuation != nil
+    }
+    
+    /**
+     Resumes the awaiting task with the result of the load, if it is still pending.
+     */
+    func resume(with result: Result<Value, any Error>) {
+        guard let continuation else { return }
+        self.continuation = nil
+        self.cancellation = nil
+        continuation.resume(with: result)
+    }
+    
+    // MARK: - Private methods
+    
+    private func cancel() {
+        isCancelled = true
+        guard isPending else { return }
+        
+        let cancellation = self.cancellation
+        resume(with: .failure(CancellationError()))
+        cancellation?()
+    }
+    
+}
+
+// MARK: - Coalescer
+
+extension SASAdLoadCoalescer {
+    
+    /**
+     Loads a banner for the given placement, or attaches to the identical banner load already in flight.
+     
+     Cancelling the calling task cancels the request: the underlying ad call is abandoned if no other waiter is
+     attached to it.
+     
+     @param adPlacement The ad placement used to load the ad.
+     @return The loaded banner, to claim before displaying it.
+     */
+    @MainActor
+    func loadBannerView(with adPlacement: SASAdPlacement) async throws -> SASCoalescedAd<SASBannerView> {
+        let continuation = SASAdLoadContinuation<SASCoalescedAd<SASBannerView>>()
+        var request: Request? = nil
+        return try await continuation.perform({
+            request = loadBannerView(with: adPlacement) { result in
+                continuation.resume(with: result)
+            }
+        }, cancellation: {
+            request?.cancel()
+        })
+    }
+    
+    /**
+     Loads the banners of several placements in parallel, each load being a child task of a task group.
+     
+     Cancelling the calling task cancels every load still in flight.
+     
+     @param adPlacements The ad placements used to load the ads.
+     @return The result of each load, in the order of the placements.
+     */
+    @MainActor
+    func loadBannerViews(with adPlacements: [SASAdPlacement]) async -> [Result<SASCoalescedAd<SASBannerView>, any Error>] {
+        return await withTaskGroup(of: (Int, Result<SASCoalescedAd<SASBannerView>, any Error>).self) { group in
+            for (index, adPlacement) in adPlacements.enumerated() {
+                group.addTask { @MainActor in
+                    do {
+                        return (index, .success(try await self.loadBannerView(with: adPlacement)))
+                    } catch {
+                        return (index, .failure(error))
+                    }
+                }
+            }
+            
+            var results = [Result<SASCoalescedAd<SASBannerView>, any Error>](repeating: .failure(CancellationError()), count: adPlacements.count)
+            for await (index, result) in group {
+                results[index] = result
+            }
+            return results
+        }
+    }
+    
+}
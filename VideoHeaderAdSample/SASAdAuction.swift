@@ -0,0 +1,303 @@
+//
+//  SASAdAuction.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import UIKit
+import SASDisplayKit
+
+/**
+ Set of placements loaded concurrently for the same slot (for instance different format ids or keyword targetings),
+ the ad with the best cleared price winning the slot.
+ 
+ Prices are compared in a reference currency: bids delivered in another currency are converted by the price
+ converter. Bids without price (non programmatic ads) or in a currency without exchange rate only win if no priced
+ bid is available.
+ */
+struct SASAdAuction {
+    
+    // MARK: - Types
+    
+    /// Errors returned by an auction when no placement has returned an ad.
+    enum LoadingError: Error {
+        /// The auction does not contain any placement.
+        case noPlacement
+        
+        /// Every placement has failed to load.
+        case noBid
+        
+        /// The deadline of the auction has been reached before any placement has returned an ad.
+        case deadlineExceeded
+    }
+    
+    // MARK: - Properties
+    
+    /// The placements competing for the slot. On equal price, the first placement wins.
+    var adPlacements: [SASAdPlacement]
+    
+    /// Time (in seconds) after which the auction is closed: the best ad received so far wins and the other ad calls
+    /// are cancelled.
+    var deadline: TimeInterval
+    
+    /// The converter of the prices to the reference currency in which they are compared.
+    var priceConverter = SASAdPriceConverter(reportingCurrency: .EUR)
+    
+    /// Returns the cleared price of an ad and the code of its currency, read from the programmatic info of the ad by
+    /// default. It can be replaced to price ads without programmatic info (for instance the ads of a simulator).
+    var clearedPrice: (SASAdInfo) -> (price: String, currencyCode: String?)? = { adInfo in
+        guard let programmaticInfo = adInfo.programmaticInfo,
+              let price = programmaticInfo.clearedPricePublisherCurrency else { return nil }
+        return (price, programmaticInfo.publisherCurrencyCode)
+    }
+    
+    /**
+     Initialize a new auction.
+     
+     @param adPlacements The placements competing for the slot.
+     @param deadline Time (in seconds) after which the auction is closed.
+     */
+    init(adPlacements: [SASAdPlacement], deadline: TimeInterval) {
+        self.adPlacements = adPlacements
+        self.deadline = deadline
+    }
+    
+    /**
+     Returns the price of an ad in the reference currency, or nil if the ad has no price or its currency cannot be
+     converted.
+     */
+    func price(of adInfo: SASAdInfo) -> SASAdPrice? {
+        guard let clearedPrice = clearedPrice(adInfo),
+              let price = SASAdPrice(clearedPrice.price) else { return nil }
+              
+        // A price without currency is considered to be in the reference currency.
+        var currency = priceConverter.reportingCurrency
+        if let currencyCode = clearedPrice.currencyCode {
+            guard let publisherCurrency = SASCurrency(code: currencyCode) else { return nil }
+            currency = publisherCurrency
+        }
+        return priceConverter.convert(price, from: currency)
+    }
+    
+}
+
+/**
+ Executor of a `SASAdAuction`, performing the ad call of every placement with an ad loader.
+ 
+ Only the best ad received so far is retained: an ad beaten by a better one is released as soon as it is received,
+ so the memory used by the auction stays bounded whatever the number of placements.
+ 
+ @note This class must only be used from the main thread.
+ */
+final class SASAdAuctionLoader {
+    
+    // MARK: - Types
+    
+    /// The winning ad of an auction.
+    struct Winner {
+        /// The loaded banner view, owned by the caller (which must set itself as its delegate).
+        let bannerView: SASBannerView
+        
+        /// The ad info of the loaded ad.
+        let adInfo: SASAdInfo
+        
+        /// The index of the winning placement.
+        let placementIndex: Int
+        
+        /// The price of the ad in the reference currency, if any.
+        let price: SASAdPrice?
+    }
+    
+    /// Report of an auction, describing its cost.
+    struct Report: Equatable {
+        /// Time (in seconds) between the start of the auction and the selection of the winner.
+        var latency: TimeInterval = 0.0
+        
+        /// Number of placements which have returned an ad before the end of the auction.
+        var bids = 0
+        
+        /// Number of placements which have failed to load before the end of the auction.
+        var failures = 0
+        
+        /// Number of ad calls cancelled at the end of the auction.
+        var cancellations = 0
+        
+        /// Highest number of banner views (loading or loaded) retained at the same time by the auction.
+        var retainedBannersHighWaterMark = 0
+        
+        /// Highest memory footprint (in bytes) of the app observed during the auction, if available.
+        var memoryHighWaterMark: UInt64 = 0
+    }
+    
+    typealias Completion = (Result<Winner, any Error>, Report) -> Void
+    
+    // MARK: - Private properties
+    
+    private let auction: SASAdAuction
+    private let loader: SASAdLoader
+    private weak var modalParentViewController: UIViewController? = nil
+    private var completion: Completion?
+    private var report = Report()
+    private var startTime: TimeInterval = 0.0
+    
+    /// Ad calls in flight, each one loading its own banner view, by placement index.
+    private var pendingAdCalls = [Int: SASAdCall]()
+    
+    /// The best ad received so far, if any.
+    private var bestBid: Winner? = nil
+    
+    private var deadlineWorkItem: DispatchWorkItem? = nil
+    
+    // MARK: - Initialization
+    
+    /**
+     Initialize a new auction loader.
+     
+     @param auction The auction to run.
+     @param loader The loader performing the ad calls of the placements.
+     */
+    init(auction: SASAdAuction, loader: SASAdLoader = SASAdSDKLoader.shared) {
+        self.auction = auction
+        self.loader = loader
+    }
+    
+    deinit {
+        deadlineWorkItem?.cancel()
+        pendingAdCalls.values.forEach { $0.cancel() }
+    }
+    
+    // MARK: - Loading API
+    
+    /**
+     Starts the auction.
+     
+     @param modalParentViewController The modal parent view controller of the banner views.
+     @param completion The block called with the winning ad (or an error) and the report of the auction.
+     */
+    func load(modalParentViewController: UIViewController?, completion: @escaping Completion) {
+        guard !auction.adPlacements.isEmpty else {
+            completion(.failure(SASAdAuction.LoadingError.noPlacement), report)
+            return
+        }
+        
+        self.modalParentViewController = modalParentViewController
+        self.completion = completion
+        startTime = CACurrentMediaTime()
+        updateHighWaterMarks()
+        
+        let deadlineWorkItem = DispatchWorkItem { [weak self] in
+            self?.finish()
+        }
+        self.deadlineWorkItem = deadlineWorkItem
+        DispatchQueue.main.asyncAfter(deadline: .now() + auction.deadline, execute: deadlineWorkItem)
+        
+        // Every placement is loaded concurrently (the loader completions are always called asynchronously).
+        for (index, adPlacement) in auction.adPlacements.enumerated() {
+            pendingAdCalls[index] = loader.loadBannerView(with: adPlacement) { [weak self] result in
+                self?.adCallDidReturn(placementIndex: index, result: result)
+            }
+        }
+        updateHighWaterMarks()
+    }
+    
+    /**
+     Cancels the auction: its completion will not be called and every ad call in flight is cancelled.
+     */
+    func cancel() {
+        completion = nil
+        deadlineWorkItem?.cancel()
+        deadlineWorkItem = nil
+        cancelPendingAdCalls()
+        bestBid = nil
+    }
+    
+    // MARK: - Private methods
+    
+    private func adCallDidReturn(placementIndex: Int, result: Result<(bannerView: SASBannerView, adInfo: SASAdInfo), any Error>) {
+        guard pendingAdCalls.removeValue(forKey: placementIndex) != nil else { return }
+        
+        switch result {
+        case .success(let loadedAd):
+            report.bids += 1
+            loadedAd.bannerView.modalParentViewController = modalParentViewController
+            
+            // The new bid only replaces the best bid if its price is strictly higher (or if the best bid has no price
+            // and the new one has), the beaten bid being released right away.
+            let bid = Winner(bannerView: loadedAd.bannerView, adInfo: loadedAd.adInfo, placementIndex: placementIndex, price: auction.price(of: loadedAd.adInfo))
+            if bestBid.map({ SASAdAuctionLoader.isBetter(bid, than: $0) }) ?? true {
+                bestBid = bid
+            }
+            updateHighWaterMarks()
+        case .failure:
+            report.failures += 1
+        }
+        
+        finishIfComplete()
+    }
+    
+    private static func isBetter(_ bid: Winner, than otherBid: Winner) -> Bool {
+        switch (bid.price, otherBid.price) {
+        case (.some(let price), .some(let otherPrice)):
+            return price > otherPrice || (price == otherPrice && bid.placementIndex < otherBid.placementIndex)
+        case (.some, .none):
+            return true
+        case (.none, .some):
+            return false
+        case (.none, .none):
+            return bid.placementIndex < otherBid.placementIndex
+        }
+    }
+    
+    private func finishIfComplete() {
+        // The auction ends as soon as every placement has returned, without waiting for the deadline.
+        if pendingAdCalls.isEmpty {
+            finish()
+        }
+    }
+    
+    private func finish() {
+        guard let completion else { return }
+        self.completion = nil
+        deadlineWorkItem?.cancel()
+        deadlineWorkItem = nil
+        
+        // The ad calls still in flight lose the auction.
+        report.cancellations = pendingAdCalls.count
+        cancelPendingAdCalls()
+        
+        report.latency = CACurrentMediaTime() - startTime
+        updateHighWaterMarks()
+        
+        let winner = bestBid
+        bestBid = nil
+        if let winner {
+            completion(.success(winner), report)
+        } else {
+            completion(.failure(report.bids + report.failures < auction.adPlacements.count ? SASAdAuction.LoadingError.deadlineExceeded : SASAdAuction.LoadingError.noBid), report)
+        }
+    }
+    
+    private func cancelPendingAdCalls() {
+        pendingAdCalls.values.forEach { $0.cancel() }
+        pendingAdCalls.removeAll()
+    }
+    
+    private func updateHighWaterMarks() {
+        let retainedBanners = pendingAdCalls.count + (bestBid == nil ? 0 : 1)
+        report.retainedBannersHighWaterMark = max(report.retainedBannersHighWaterMark, retainedBanners)
+        
+        // The memory footprint is the one reported by the system for the whole app (including the ad creatives).
+        var info = task_vm_info_data_t()
+        var count = mach_msg_type_number_t(MemoryLayout<task_vm_info_data_t>.size / MemoryLayout<integer_t>.size)
+        let result = withUnsafeMutablePointer(to: &info) {
+            $0.withMemoryRebound(to: integer_t.self, capacity: Int(count)) {
+                task_info(mach_task_self_, task_flavor_t(TASK_VM_INFO), $0, &count)
+            }
+        }
+        if result == KERN_SUCCESS {
+            report.memoryHighWaterMark = max(report.memoryHighWaterMark, info.phys_footprint)
+        }
+    }
+    
+}
@@ -0,0 +1,186 @@
+//
+//  SASAdCallTimeoutPolicy.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import Foundation
+import SASDisplayKit
+
+/**
+ Error returned when an ad call is cancelled because it has exceeded the adapted timeout of its placement.
+ */
+struct SASAdCallTimeoutError: Error, Equatable {
+    /// The timeout exceeded by the ad call (in seconds).
+    let timeout: TimeInterval
+}
+
+/**
+ Per-placement adaptive ad call timeout.
+ 
+ `SASConfiguration.adCallTimeout` is a single value for every placement. This policy derives a timeout for each
+ placement from the latencies of its previous ad calls (a percentile of the recent latencies, with a margin), bounded
+ by a floor and a ceiling.
+ 
+ The SDK configuration is never modified: the adapted timeout is enforced by the `SASAdLoadCoalescer`, which cancels
+ an ad call still running after the timeout of its placement and fails it with a `SASAdCallTimeoutError`. Since the
+ SDK keeps applying the global `SASConfiguration.adCallTimeout`, an adapted timeout can only shorten it.
+ 
+ Until enough ad calls have been observed for a placement, the global `SASConfiguration.adCallTimeout` is used.
+ 
+ @note This class must only be used from the main thread.
+ */
+final class SASAdCallTimeoutPolicy {
+    
+    // MARK: - Types
+    
+    /// Configuration of the adaptive timeout of a placement.
+    struct Configuration: Equatable {
+        /// Percentile (between 0 and 100) of the recent latencies the timeout is derived from.
+        var percentile = 95.0
+        
+        /// Factor applied to the latency percentile to get the timeout.
+        var multiplier = 1.5
+        
+        /// Lowest timeout (in seconds).
+        var floor: TimeInterval = 1.0
+        
+        /// Highest timeout (in seconds).
+        var ceiling: TimeInterval = 10.0
+        
+        /// Number of ad calls to observe before the timeout is adapted.
+        var minimumSampleCount = 20
+        
+        /// Number of ad calls after which the oldest latencies are forgotten, so the timeout follows the network
+        /// conditions.
+        var windowSampleCount = 200
+    }
+    
+    /**
+     Estimator of the adaptive timeout of a single placement.
+     
+     Latencies are recorded in two windows of `windowSampleCount` ad calls: when the current window is full, the
+     previous one is discarded, so the estimate is based on the last `windowSampleCount` to `2 * windowSampleCount`
+     ad calls.
+     */
+    struct Estimator {
+        let configuration: Configuration
+        
+        private var currentWindow = SASLatencyHistogram()
+        private var previousWindow = SASLatencyHistogram()
+        
+        init(configuration: Configuration) {
+            self.configuration = configuration
+        }
+        
+        /// The adapted timeout (in seconds), or nil if not enough ad calls have been observed yet.
+        var timeout: TimeInterval? {
+            var histogram = previousWindow
+            histogram.merge(currentWindow)
+            guard histogram.count >= UInt64(configuration.minimumSampleCount) else { return nil }
+            
+            let latency = TimeInterval(histogram.value(atPercentile: configuration.percentile)) / 1_000_000.0
+            return min(max(latency * configuration.multiplier, configuration.floor), configuration.ceiling)
+        }
+        
+        /**
+         Records the outcome of an ad call.
+         
+         @param duration The duration of the ad call (in seconds).
+         @param timeout The timeout applied to the ad call (in seconds), if known.
+         @param succeeded Whether an ad has been loaded.
+         */
+        mutating func recordAdCall(duration: TimeInterval, timeout: TimeInterval?, succeeded: Bool) {
+            // A failed ad call lasting as long as its timeout has timed out: its actual latency is unknown but at
+            // least equal to the timeout, which is recorded so the estimate can grow back.
+            var latency = duration
+            if !succeeded, let timeout, duration >= timeout * SASAdCallTimeoutPolicy.TIMEOUT_DETECTION_RATIO {
+                latency = max(duration, timeout)
+            }
+            
+            if currentWindow.count >= UInt64(configuration.windowSampleCount) {
+                previousWindow = currentWindow
+                currentWindow = SASLatencyHistogram()
+            }
+            currentWindow.record(microseconds: UInt64(max(latency, 0.0) * 1_000_000.0))
+        }
+    }
+    
+    // MARK: - Constants
+    
+    /// Ratio of its timeout after which a failed ad call is considered as timed out.
+    static let TIMEOUT_DETECTION_RATIO = 0.95
+    
+    // MARK: - Properties
+    
+    /// The configuration used by the placements without a specific configuration.
+    ///
+    /// @note Changing the configuration only applies to the placements not observed yet.
+    var defaultConfiguration = Configuration()
+    
+    // MARK: - Private properties
+    
+    private var configurations = [SASAdPlacementKey: Configuration]()
+    private var estimators = [SASAdPlacementKey: Estimator]()
+    
+    // MARK: - Public API
+    
+    /**
+     Sets a specific configuration for a placement, for instance looser bounds for a placement only used for prefetching
+     or tighter ones for a placement displayed on a cold screen.
+     
+     @param configuration The configuration of the placement.
+     @param adPlacement The ad placement.
+     */
+    func setConfiguration(_ configuration: Configuration, for adPlacement: SASAdPlacement) {
+        let key = adPlacement.placementKey
+        configurations[key] = configuration
+        estimators[key] = nil
+    }
+    
+    /**
+     Returns the timeout applied to the next ad call of a placement.
+     
+     @param adPlacement The ad placement.
+     @return The adapted timeout of the placement (in seconds), or the global timeout if it has not been adapted yet.
+     */
+    func timeout(for adPlacement: SASAdPlacement) -> TimeInterval {
+        return timeout(for: adPlacement.placementKey)
+    }
+    
+    /**
+     Records the outcome of an ad call performed outside of the `SASAdLoadCoalescer`.
+     
+     @param adPlacement The ad placement.
+     @param duration The duration of the ad call (in seconds).
+     @param timeout The timeout applied to the ad call (in seconds), if known.
+     @param succeeded Whether an ad has been loaded.
+     */
+    func recordAdCall(for adPlacement: SASAdPlacement, duration: TimeInterval, timeout: TimeInterval?, succeeded: Bool) {
+        recordAdCall(for: adPlacement.placementKey, duration: duration, timeout: timeout, succeeded: succeeded)
+    }
+    
+    // MARK: - Internal API
+    
+    func timeout(for key: SASAdPlacementKey) -> TimeInterval {
+        return adaptedTimeout(for: key) ?? SASConfiguration.shared.adCallTimeout
+    }
+    
+    /**
+     Returns the adapted timeout of a placement, if enough ad calls have been observed for it.
+     
+     @param key The key of the ad placement.
+     @return The adapted timeout (in seconds), never longer than the global timeout, or nil if it has not been adapted yet.
+     */
+    func adaptedTimeout(for key: SASAdPlacementKey) -> TimeInterval? {
+        guard let timeout = estimators[key]?.timeout else { return nil }
+        return min(timeout, SASConfiguration.shared.adCallTimeout)
+    }
+    
+    func recordAdCall(for key: SASAdPlacementKey, duration: TimeInterval, timeout: TimeInterval?, succeeded: Bool) {
+        estimators[key, default: Estimator(configuration: configurations[key] ?? defaultConfiguration)]
+            .recordAdCall(duration: duration, timeout: timeout, succeeded: succeeded)
+    }
+    
+}
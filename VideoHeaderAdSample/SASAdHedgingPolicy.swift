@@ -0,0 +1,118 @@
+//
+//  SASAdHedgingPolicy.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import Foundation
+import SASDisplayKit
+
+/**
+ Hedging of the slow ad calls.
+ 
+ When an ad call has not returned after a given percentile of the latencies previously observed on its placement,
+ a second identical ad call is started: the first ad returned wins and the other ad call is cancelled. This cuts the
+ tail latency of the ad calls at the cost of a few extra ad calls, capped by a budget.
+ 
+ @note This class must only be used from the main thread.
+ */
+final class SASAdHedgingPolicy {
+    
+    // MARK: - Types
+    
+    /// Configuration of the hedging.
+    struct Configuration: Equatable {
+        /// Percentile (between 0 and 100) of the latencies of a placement after which an ad call is hedged.
+        var percentile = 90.0
+        
+        /// Lowest delay (in seconds) before an ad call is hedged.
+        var minimumDelay: TimeInterval = 0.1
+        
+        /// Number of ad calls to observe on a placement before its ad calls can be hedged.
+        var minimumSampleCount = 20
+        
+        /// Number of hedges allowed per ad call, on average (0.1 means that at most 10% extra ad calls are performed).
+        var budgetRatio = 0.1
+        
+        /// Highest number of hedges which can be performed in a row when the budget has been saved up.
+        var maximumBurst = 5.0
+    }
+    
+    /// Counters describing the hedging activity.
+    struct Counters: Equatable {
+        /// Number of hedge ad calls performed.
+        var hedges = 0
+        
+        /// Number of hedge ad calls which returned before the ad call they were hedging.
+        var wins = 0
+        
+        /// Number of hedges not performed because the budget was exhausted.
+        var budgetDenials = 0
+    }
+    
+    // MARK: - Properties
+    
+    /// The configuration of the hedging.
+    let configuration: Configuration
+    
+    /// Counters of the policy since its creation.
+    private(set) var counters = Counters()
+    
+    // MARK: - Private properties
+    
+    /// The hedge budget: each ad call earns `budgetRatio` token, each hedge spends one.
+    private var budget: SASTokenBucket
+    private var latencies = [SASAdPlacementKey: SASLatencyHistogram]()
+    
+    // MARK: - Initialization
+    
+    /**
+     Initialize a new hedging policy.
+     
+     @param configuration The configuration of the hedging.
+     */
+    init(configuration: Configuration = Configuration()) {
+        self.configuration = configuration
+        self.budget = SASTokenBucket(ratio: configuration.budgetRatio, maximumBurst: configuration.maximumBurst)
+    }
+    
+    // MARK: - Internal API
+    
+    /**
+     Returns the delay after which an ad call starting now on the given placement should be hedged.
+     
+     @param key The key of the ad placement.
+     @return The delay (in seconds), or nil if not enough ad calls have been observed on this placement.
+     */
+    func adCallDidStart(for key: SASAdPlacementKey) -> TimeInterval? {
+        budget.adCallDidStart()
+        
+        guard let histogram = latencies[key], histogram.count >= UInt64(configuration.minimumSampleCount) else { return nil }
+        let latency = TimeInterval(histogram.value(atPercentile: configuration.percentile)) / 1_000_000.0
+        return max(latency, configuration.minimumDelay)
+    }
+    
+    /**
+     Requests the permission to hedge an ad call, spending the budget if granted.
+     */
+    func requestHedge() -> Bool {
+        guard budget.spend() else {
+            counters.budgetDenials += 1
+            return false
+        }
+        counters.hedges += 1
+        return true
+    }
+    
+    /**
+     Records the duration of an ad call (including its hedge, if any).
+     */
+    func recordAdCall(for key: SASAdPlacementKey, duration: TimeInterval, hedgeDidWin: Bool) {
+        latencies[key, default: SASLatencyHistogram()].record(microseconds: UInt64(max(duration, 0.0) * 1_000_000.0))
+        if hedgeDidWin {
+            counters.wins += 1
+        }
+    }
+    
+}
@@ -0,0 +1,438 @@
+//
+//  SASAdLifecycleTracer.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import Foundation
+
+/**
+ Low-overhead tracer of the lifecycle of the ads, from the ad call to the close of the ad.
+ 
+ Each ad load is a trace: its phases are recorded with a monotonic timestamp into a buffer owned by the recording
+ thread, so recording never contends with other threads. The buffers are only aggregated when the data is queried,
+ into one latency histogram per placement and per phase (the latency of a phase being the time elapsed since the
+ ad call of its trace).
+ 
+ The aggregated data can be queried in-process or dumped as JSON for offline analysis.
+ */
+final class SASAdLifecycleTracer {
+    
+    // MARK: - Shared instance
+    
+    /// The shared tracer, which can be set as the tracer of the `SASVideoHeaderAdCell` instances to trace.
+    static let shared = SASAdLifecycleTracer()
+    
+    // MARK: - Constants
+    
+    /// Maximum number of events kept by each thread buffer between two aggregations. Events recorded while a
+    /// buffer is full are dropped (and counted).
+    static let THREAD_BUFFER_CAPACITY = 4096
+    
+    /// Maximum number of traces waiting for their last phase. The oldest traces are discarded beyond this limit.
+    static let MAX_OPEN_TRACES = 1024
+    
+    // MARK: - Types
+    
+    /// A phase of the lifecycle of an ad.
+    enum Phase: String, CaseIterable, Encodable, CodingKeyRepresentable {
+        /// The ad call has been requested (start of the trace).
+        case loadAd
+        
+        /// The ad has been loaded.
+        case didLoad
+        
+        /// The ad has failed to load (end of the trace).
+        case didFailToLoad
+        
+        /// The first frame has been displayed after the ad has been loaded.
+        case firstFrame
+        
+        /// The ad has been stuck over the table view for the first time.
+        case stick
+        
+        /// The ad has been clicked for the first time.
+        case click
+        
+        /// The ad has been closed (end of the trace).
+        case close
+        
+        fileprivate var endsTrace: Bool {
+            return self == .didFailToLoad || self == .close
+        }
+    }
+    
+    /// Identifier of a trace.
+    struct TraceID: Hashable {
+        fileprivate let rawValue: UInt64
+    }
+    
+    /// Aggregated data of the tracer.
+    struct Snapshot: Encodable {
+        /// Latency histograms of each placement, by phase.
+        var placements: [String: [Phase: SASLatencyHistogram]]
+        
+        /// Number of events dropped because a thread buffer was full.
+        var droppedEvents: Int
+        
+        /// Number of traces discarded before their last phase because too many traces were open.
+        var discardedTraces: Int
+    }
+    
+    // MARK: - Properties
+    
+    /// Whether the tracer records the events. Recording is a no-op when disabled.
+    var isEnabled = true
+    
+    // MARK: - Private properties
+    
+    private struct Event {
+        let trace: UInt64
+        let phase: Phase
+        let timestamp: UInt64
+    }
+    
+    private struct OpenTrace {
+        let placement: String
+        let startTimestamp: UInt64
+        var recordedPhases: Set<Phase>
+    }
+    
+    /// Buffer of events owned by a single thread. Its lock is only contended while the tracer aggregates it.
+    private final class ThreadBuffer {
+        let index: UInt64
+        let lock = NSLock()
+        var events = [Event]()
+        var placements = [(trace: UInt64, placement: String)]()
+        var droppedEvents = 0
+        var nextTrace: UInt64 = 0
+        
+        init(index: UInt64) {
+            self.index = index
+            events.reserveCapacity(SASAdLifecycleTracer.THREAD_BUFFER_CAPACITY)
+        }
+    }
+    
+    private let threadDictionaryKey: String
+    
+    /// Lock protecting the list of buffers and the aggregated data.
+    private let lock = NSLock()
+    private var buffers = [ThreadBuffer]()
+    private var openTraces = [UInt64: OpenTrace]()
+    private var histograms = [String: [Phase: SASLatencyHistogram]]()
+    private var droppedEvents = 0
+    private var discardedTraces = 0
+    
+    // MARK: - Initialization
+    
+    init() {
+        threadDictionaryKey = "SASAdLifecycleTracer.\(UUID().uuidString)"
+    }
+    
+    // MARK: - Recording
+    
+    /**
+     Starts a new trace, recording its 'loadAd' phase.
+     
+     @param placement The name of the placement the ad is loaded for, used to aggregate the traces.
+     @return The identifier of the new trace, or nil if the tracer is disabled or if the buffer of the thread is full
+     (the trace is then dropped with its 'loadAd' event).
+     */
+    func beginTrace(placement: String) -> TraceID? {
+        guard isEnabled else { return nil }
+        
+        let buffer = currentThreadBuffer()
+        buffer.lock.lock()
+        defer { buffer.lock.unlock() }
+        
+        guard buffer.events.count < SASAdLifecycleTracer.THREAD_BUFFER_CAPACITY else {
+            buffer.droppedEvents += 1
+            return nil
+        }
+        
+        // The identifier is unique without any synchronization: it combines the index of the buffer with a counter
+        // only incremented by its own thread.
+        buffer.nextTrace += 1
+        let trace = buffer.index << 40 | buffer.nextTrace
+        buffer.placements.append((trace, placement))
+        append(Event(trace: trace, phase: .loadAd, timestamp: SASAdLifecycleTracer.now()), to: buffer)
+        return TraceID(rawValue: trace)
+    }
+    
+    /**
+     Records a phase of a trace. Only the first occurrence of each phase is taken into account.
+     
+     @param phase The phase reached by the trace.
+     @param trace The trace identifier returned by `beginTrace(placement:)`.
+     */
+    func record(_ phase: Phase, trace: TraceID?) {
+        guard isEnabled, let trace else { return }
+        
+        let buffer = currentThreadBuffer()
+        buffer.lock.lock()
+        append(Event(trace: trace.rawValue, phase: phase, timestamp: SASAdLifecycleTracer.now()), to: buffer)
+        buffer.lock.unlock()
+    }
+    
+    // MARK: - Querying
+    
+    /**
+     Returns the latency histogram of a phase for a placement.
+     
+     @param phase The phase.
+     @param placement The name of the placement.
+     @return The histogram of the time elapsed between the ad call and the phase, or nil if the phase has never been
+     recorded for this placement.
+     */
+    func histogram(for phase: Phase, placement: String) -> SASLatencyHistogram? {
+        lock.lock()
+        defer { lock.unlock() }
+        aggregate()
+        return histograms[placement]?[phase]
+    }
+    
+    /**
+     Returns all the aggregated data of the tracer.
+     */
+    func snapshot() -> Snapshot {
+        lock.lock()
+        defer { lock.unlock() }
+        aggregate()
+        return Snapshot(placements: histograms, droppedEvents: droppedEvents, discardedTraces: discardedTraces)
+    }
+    
+    /**
+     Returns all the aggregated data of the tracer as JSON, for offline analysis.
+     */
+    func jsonData() throws -> Data {
+        let encoder = JSONEncoder()
+        encoder.outputFormatting = [.prettyPrinted, .sortedKeys]
+        return try encoder.encode(snapshot())
+    }
+    
+    /**
+     Discards all the recorded and aggregated data.
+     */
+    func reset() {
+        lock.lock()
+        defer { lock.unlock() }
+        aggregate()
+        openTraces.removeAll()
+        histograms.removeAll()
+        droppedEvents = 0
+        discardedTraces = 0
+    }
+    
+    // MARK: - Private methods
+    
+    private static func now() -> UInt64 {
+        return DispatchTime.now().uptimeNanoseconds
+    }
+    
+    private func append(_ event: Event, to buffer: ThreadBuffer) {
+        if buffer.events.count < SASAdLifecycleTracer.THREAD_BUFFER_CAPACITY {
+            buffer.events.append(event)
+        } else {
+            buffer.droppedEvents += 1
+        }
+    }
+    
+    private func currentThreadBuffer() -> ThreadBuffer {
+        let threadDictionary = Thread.current.threadDictionary
+        if let buffer = threadDictionary[threadDictionaryKey] as? ThreadBuffer {
+            return buffer
+        }
+        
+        // The global lock is only taken the first time a thread records an event.
+        lock.lock()
+        let buffer = ThreadBuffer(index: UInt64(buffers.count))
+        buffers.append(buffer)
+        lock.unlock()
+        
+        threadDictionary[threadDictionaryKey] = buffer
+        return buffer
+    }
+    
+    /// Moves the events of every thread buffer into the histograms. Must be called with the global lock held.
+    private func aggregate() {
+        var events = [Event]()
+        var placements = [UInt64: String]()
+        for buffer in buffers {
+            buffer.lock.lock()
+            events.append(contentsOf: buffer.events)
+            buffer.events.removeAll(keepingCapacity: true)
+            for (trace, placement) in buffer.placements {
+                placements[trace] = placement
+            }
+            buffer.placements.removeAll()
+            droppedEvents += buffer.droppedEvents
+            buffer.droppedEvents = 0
+            buffer.lock.unlock()
+        }
+        guard !events.isEmpty else { return }
+        
+        // Events of a trace can be recorded by several threads: they are processed in chronological order.
+        events.sort { $0.timestamp < $1.timestamp }
+        
+        for event in events {
+            // A trace is opened by its 'loadAd' event, which carries its start timestamp: the events of a trace whose
+            // 'loadAd' event has never been seen (or which has already ended) are skipped.
+            if event.phase == .loadAd {
+                if let placement = placements[event.trace] {
+                    openTraces[event.trace] = OpenTrace(placement: placement, startTimestamp: event.timestamp, recordedPhases: [.loadAd])
+                }
+                continue
+            }
+            guard var openTrace = openTraces[event.trace], !openTrace.recordedPhases.contains(event.phase) else { continue }
+            openTrace.recordedPhases.insert(event.phase)
+            
+            let latency = (event.timestamp &- openTrace.startTimestamp) / 1_000
+            histograms[openTrace.placement, default: [:]][event.phase, default: SASLatencyHistogram()].record(microseconds: latency)
+            
+            if event.phase.endsTrace {
+                openTraces[event.trace] = nil
+            } else {
+                openTraces[event.trace] = openTrace
+            }
+        }
+        
+        // Traces which never end (for instance an ad cell never closed) are discarded, oldest first, so the tracer
+        // memory stays bounded.
+        if openTraces.count > SASAdLifecycleTracer.MAX_OPEN_TRACES {
+            let excess = openTraces.count - SASAdLifecycleTracer.MAX_OPEN_TRACES
+            for trace in openTraces.sorted(by: { $0.value.startTimestamp < $1.value.startTimestamp }).prefix(excess) {
+                openTraces[trace.key] = nil
+            }
+            discardedTraces += excess
+        }
+    }
+    
+}
+
+// MARK: - Latency histogram
+
+/**
+ High dynamic range histogram of latencies, from 1 microsecond to 1 hour, with 2 significant digits of precision.
+ 
+ Latencies are counted in log-linear buckets: the memory used by the histogram is fixed and recording a value is
+ a constant time operation.
+ */
+struct SASLatencyHistogram: Encodable, Equatable {
+    
+    /// Highest latency (in microseconds) tracked by the histogram. Higher latencies are counted as this value.
+    static let HIGHEST_TRACKABLE_VALUE: UInt64 = 3_600_000_000
+    
+    /// Number of sub-buckets of each bucket, enough for 2 significant digits (must be a power of 2).
+    private static let SUB_BUCKET_COUNT_MAGNITUDE: UInt64 = 8
+    private static let SUB_BUCKET_HALF_COUNT_MAGNITUDE = SUB_BUCKET_COUNT_MAGNITUDE - 1
+    private static let SUB_BUCKET_HALF_COUNT = 1 << SUB_BUCKET_HALF_COUNT_MAGNITUDE
+    private static let COUNTS_LENGTH = index(of: HIGHEST_TRACKABLE_VALUE) + 1
+    
+    /// Number of recorded latencies.
+    private(set) var count: UInt64 = 0
+    
+    /// Lowest recorded latency (in microseconds).
+    private(set) var min: UInt64 = 0
+    
+    /// Highest recorded latency (in microseconds).
+    private(set) var max: UInt64 = 0
+    
+    /// Sum of the recorded latencies (in microseconds).
+    private(set) var sum: UInt64 = 0
+    
+    private var counts = [UInt64](repeating: 0, count: SASLatencyHistogram.COUNTS_LENGTH)
+    
+    /// Mean of the recorded latencies (in microseconds).
+    var mean: Double {
+        return count > 0 ? Double(sum) / Double(count) : 0.0
+    }
+    
+    /**
+     Records a latency.
+     
+     @param microseconds The latency, in microseconds.
+     */
+    mutating func record(microseconds: UInt64) {
+        let value = Swift.min(microseconds, SASLatencyHistogram.HIGHEST_TRACKABLE_VALUE)
+        counts[SASLatencyHistogram.index(of: value)] += 1
+        min = count == 0 ? value : Swift.min(min, value)
+        max = Swift.max(max, value)
+        sum += value
+        count += 1
+    }
+    
+    /**
+     Returns the latency (in microseconds) below which the given ratio of the recorded latencies falls.
+     
+     @param percentile The percentile, between 0 and 100.
+     @return The latency, with 2 significant digits of precision.
+     */
+    func value(atPercentile percentile: Double) -> UInt64 {
+        guard count > 0 else { return 0 }
+        
+        let target = Swift.max(1, UInt64((Swift.min(Swift.max(percentile, 0.0), 100.0) / 100.0 * Double(count)).rounded(.up)))
+        var cumulativeCount: UInt64 = 0
+        for (index, bucketCount) in counts.enumerated() where bucketCount > 0 {
+            cumulativeCount += bucketCount
+            if cumulativeCount >= target {
+                return Swift.min(SASLatencyHistogram.highestEquivalentValue(at: index), max)
+            }
+        }
+        return max
+    }
+    
+    /**
+     Adds the latencies recorded by another histogram to this histogram.
+     */
+    mutating func merge(_ other: SASLatencyHistogram) {
+        guard other.count > 0 else { return }
+        for index in counts.indices {
+            counts[index] += other.counts[index]
+        }
+        min = count == 0 ? other.min : Swift.min(min, other.min)
+        max = Swift.max(max, other.max)
+        sum += other.sum
+        count += other.count
+    }
+    
+    // MARK: - Buckets
+    
+    private static func index(of value: UInt64) -> Int {
+        // The bucket is given by the magnitude of the value, the sub-bucket by its most significant bits.
+        let bucketIndex = UInt64(63 - (value | UInt64(SUB_BUCKET_HALF_COUNT * 2 - 1)).leadingZeroBitCount) - SUB_BUCKET_HALF_COUNT_MAGNITUDE
+        let subBucketIndex = value >> bucketIndex
+        return Int(bucketIndex) << Int(SUB_BUCKET_HALF_COUNT_MAGNITUDE) + Int(subBucketIndex)
+    }
+    
+    private static func highestEquivalentValue(at index: Int) -> UInt64 {
+        var bucketIndex = (index >> Int(SUB_BUCKET_HALF_COUNT_MAGNITUDE)) - 1
+        var subBucketIndex = (index & (SUB_BUCKET_HALF_COUNT - 1)) + SUB_BUCKET_HALF_COUNT
+        if bucketIndex < 0 {
+            subBucketIndex -= SUB_BUCKET_HALF_COUNT
+            bucketIndex = 0
+        }
+        return (UInt64(subBucketIndex) << UInt64(bucketIndex)) + (1 << UInt64(bucketIndex)) - 1
+    }
+    
+    // MARK: - Coding
+    
+    private enum CodingKeys: String, CodingKey {
+        case count, min, max, mean, p50, p90, p95, p99, p999
+    }
+    
+    /// Histograms are encoded as a summary of their latencies (in microseconds).
+    func encode(to encoder: any Encoder) throws {
+        var container = encoder.container(keyedBy: CodingKeys.self)
+        try container.encode(count, forKey: .count)
+        try container.encode(min, forKey: .min)
+        try container.encode(max, forKey: .max)
+        try container.encode(mean, forKey: .mean)
+        try container.encode(value(atPercentile: 50.0), forKey: .p50)
+        try container.encode(value(atPercentile: 90.0), forKey: .p90)
+        try container.encode(value(atPercentile: 95.0), forKey: .p95)
+        try container.encode(value(atPercentile: 99.0), forKey: .p99)
+        try container.encode(value(atPercentile: 99.9), forKey: .p999)
+    }
+    
+}
@@ -0,0 +1,412 @@
+//
+//  SASAdLoadCoalescer.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import UIKit
+import SASDisplayKit
+
+/**
+ Ad loaded through the `SASAdLoadCoalescer`.
+ 
+ The same instance is delivered to every waiter of a coalesced load. Since an ad can only be displayed once,
+ a waiter willing to display it must claim it first: only the first claim succeeds.
+ */
+final class SASCoalescedAd<Ad: AnyObject> {
+    
+    /// The loaded ad object (a `SASBannerView` or a `SASInterstitialManager`).
+    let ad: Ad
+    
+    /// The ad info related to the loaded ad.
+    let adInfo: SASAdInfo
+    
+    /// Whether the ad has already been claimed by a waiter.
+    private(set) var isClaimed = false
+    
+    private var claimObservers = [() -> Void]()
+    
+    init(ad: Ad, adInfo: SASAdInfo) {
+        self.ad = ad
+        self.adInfo = adInfo
+    }
+    
+    /**
+     Claims the ownership of the ad.
+     
+     @return true if the ad has been claimed by the caller, false if it was already claimed by another waiter.
+     */
+    func claim() -> Bool {
+        guard !isClaimed else { return false }
+        isClaimed = true
+        
+        let observers = claimObservers
+        claimObservers.removeAll()
+        observers.forEach { $0() }
+        return true
+    }
+    
+    /**
+     Registers a block called once the ad has been claimed (right away if it has already been claimed), so a waiter
+     keeping the ad aside can release it as soon as another waiter displays it.
+     
+     @param observer The block called when the ad is claimed.
+     */
+    func observeClaim(_ observer: @escaping () -> Void) {
+        guard !isClaimed else {
+            observer()
+            return
+        }
+        claimObservers.append(observer)
+    }
+    
+}
+
+/**
+ Coalesces identical ad loads.
+ 
+ When several loads are requested for the same placement while a load is already in flight (for instance when
+ the user quickly navigates back and forth to a screen), no additional ad call is performed: every waiter is
+ attached to the in-flight load and receives its result.
+ 
+ @note This class must only be used from the main thread.
+ */
+class SASAdLoadCoalescer: NSObject {
+    
+    // MARK: - Shared instance
+    
+    /// The shared coalescer, used by default by `SASVideoHeaderAdCell` and `SASAdPrefetchCache`.
+    static let shared = SASAdLoadCoalescer()
+    
+    // MARK: - Types
+    
+    typealias BannerCompletion = (Result<SASCoalescedAd<SASBannerView>, any Error>) -> Void
+    typealias InterstitialCompletion = (Result<SASCoalescedAd<SASInterstitialManager>, any Error>) -> Void
+    
+    /// Counters describing the efficiency of the coalescer.
+    struct Counters: Equatable {
+        /// Number of ad calls actually performed.
+        var adCalls = 0
+        
+        /// Number of loads attached to an ad call already in flight.
+        var coalescedLoads = 0
+        
+        /// Number of in-flight loads abandoned because all their waiters have been cancelled.
+        var abandonedLoads = 0
+    }
+    
+    /**
+     A load requested to the coalescer, which can be cancelled if its result is not needed anymore.
+     */
+    final class Request {
+        fileprivate weak var load: InFlightLoad?
+        fileprivate let waiterId: Int
+        
+        fileprivate init(load: InFlightLoad, waiterId: Int) {
+            self.load = load
+            self.waiterId = waiterId
+        }
+        
+        /**
+         Cancels the request: its completion will not be called.
+         
+         The underlying ad call is abandoned if no other waiter is attached to it.
+         */
+        func cancel() {
+            load?.removeWaiter(waiterId)
+        }
+    }
+    
+    // MARK: - Public properties
+    
+    /// The loader performing the ad calls of the coalescer.
+    let loader: SASAdLoader
+    
+    /// Counters of the coalescer since its creation.
+    private(set) var counters = Counters()
+    
+    /// The policy adapting the timeout of the ad calls performed by the coalescer to their placement, if any.
+    ///
+    /// An ad call exceeding the adapted timeout of its placement is cancelled and fails with a `SASAdCallTimeoutError`.
+    /// Leaving this value to 'nil' means that every ad call uses the global `SASConfiguration.adCallTimeout`.
+    var timeoutPolicy: SASAdCallTimeoutPolicy? = nil
+    
+    /// The policy hedging the slow ad calls performed by the coalescer, if any.
+    ///
+    /// Leaving this value to 'nil' means that ad calls are never hedged.
+    var hedgingPolicy: SASAdHedgingPolicy? = nil
+    
+    // MARK: - Private properties
+    
+    fileprivate struct LoadKey: Hashable {
+        enum Kind {
+            case banner
+            case interstitial
+        }
+        
+        let kind: Kind
+        let placement: SASAdPlacementKey
+    }
+    
+    private var inFlightLoads = [LoadKey: InFlightLoad]()
+    private var nextWaiterId = 0
+    
+    // MARK: - Initialization
+    
+    /**
+     Initialize a new coalescer.
+     
+     @param loader The loader performing the ad calls: the SDK by default.
+     */
+    init(loader: SASAdLoader = SASAdSDKLoader.shared) {
+        self.loader = loader
+        super.init()
+    }
+    
+    // MARK: - Loading API
+    
+    /**
+     Loads a banner for the given placement, or attaches to the identical banner load already in flight.
+     
+     @param adPlacement The ad placement used to load the ad.
+     @param completion The block called with the loaded banner (to claim before displaying it) or the loading error.
+     @return The request, which can be cancelled.
+     */
+    @discardableResult
+    func loadBannerView(with adPlacement: SASAdPlacement, completion: @escaping BannerCompletion) -> Request {
+        let key = LoadKey(kind: .banner, placement: adPlacement.placementKey)
+        return attach(to: key, start: { BannerLoad(key: key, coalescer: self, adPlacement: adPlacement) }) { result in
+            completion(result.map { $0 as! SASCoalescedAd<SASBannerView> })
+        }
+    }
+    
+    /**
+     Loads an interstitial for the given placement, or attaches to the identical interstitial load already in flight.
+     
+     @param adPlacement The ad placement used to load the ad.
+     @param completion The block called with the loaded interstitial manager (to claim before showing it) or the loading error.
+     @return The request, which can be cancelled.
+     */
+    @discardableResult
+    func loadInterstitial(with adPlacement: SASAdPlacement, completion: @escaping InterstitialCompletion) -> Request {
+        let key = LoadKey(kind: .interstitial, placement: adPlacement.placementKey)
+        return attach(to: key, start: { InterstitialLoad(key: key, coalescer: self, adPlacement: adPlacement) }) { result in
+            completion(result.map { $0 as! SASCoalescedAd<SASInterstitialManager> })
+        }
+    }
+    
+    // MARK: - Internal logic
+    
+    private func attach(to key: LoadKey, start: () -> InFlightLoad, waiter: @escaping InFlightLoad.Waiter) -> Request {
+        let waiterId = nextWaiterId
+        nextWaiterId += 1
+        
+        if let load = inFlightLoads[key] {
+            // An identical load is already in flight: no new ad call is performed.
+            counters.coalescedLoads += 1
+            load.addWaiter(waiterId, waiter)
+            return Request(load: load, waiterId: waiterId)
+        }
+        
+        let load = start()
+        inFlightLoads[key] = load
+        load.addWaiter(waiterId, waiter)
+        counters.adCalls += 1
+        load.begin(timeoutPolicy: timeoutPolicy, hedgingPolicy: hedgingPolicy)
+        return Request(load: load, waiterId: waiterId)
+    }
+    
+    fileprivate func loadDidFinish(_ load: InFlightLoad) {
+        if inFlightLoads[load.key] === load {
+            inFlightLoads[load.key] = nil
+        }
+    }
+    
+    fileprivate func loadWasAbandoned(_ load: InFlightLoad) {
+        loadDidFinish(load)
+        counters.abandonedLoads += 1
+    }
+    
+}
+
+// MARK: - In-flight loads
+
+/**
+ Base class of an ad call in flight, shared by all its waiters.
+ 
+ An in-flight load performs one ad call (called an attempt) with the loader of the coalescer, or two if it is hedged:
+ the first attempt returning an ad wins and the other one is cancelled.
+ */
+private class InFlightLoad {
+    
+    typealias Waiter = (Result<AnyObject, any Error>) -> Void
+    
+    let key: SASAdLoadCoalescer.LoadKey
+    let adPlacement: SASAdPlacement
+    let loader: SASAdLoader
+    weak var coalescer: SASAdLoadCoalescer?
+    
+    private var waiters = [(id: Int, block: Waiter)]()
+    
+    /// The ad calls of the attempts, the first one being the initial attempt and the next one its hedge.
+    private var adCalls = [SASAdCall]()
+    
+    private var timeoutPolicy: SASAdCallTimeoutPolicy? = nil
+    private var hedgingPolicy: SASAdHedgingPolicy? = nil
+    private var appliedTimeout: TimeInterval? = nil
+    private var startTime: TimeInterval = 0.0
+    
+    /// The scheduled hedge of the ad call, if any.
+    private var hedgeWorkItem: DispatchWorkItem? = nil
+    
+    /// The scheduled expiration of the adapted timeout of the ad call, if any.
+    private var timeoutWorkItem: DispatchWorkItem? = nil
+    
+    /// Number of attempts started and not returned yet.
+    private var pendingAttempts = 0
+    
+    init(key: SASAdLoadCoalescer.LoadKey, coalescer: SASAdLoadCoalescer, adPlacement: SASAdPlacement) {
+        self.key = key
+        self.adPlacement = adPlacement
+        self.loader = coalescer.loader
+        self.coalescer = coalescer
+    }
+    
+    func begin(timeoutPolicy: SASAdCallTimeoutPolicy?, hedgingPolicy: SASAdHedgingPolicy?) {
+        self.timeoutPolicy = timeoutPolicy
+        self.hedgingPolicy = hedgingPolicy
+        startTime = CACurrentMediaTime()
+        
+        // The adapted timeout of the placement is enforced here, hedge included, the SDK only applying the global one.
+        if let timeoutPolicy {
+            appliedTimeout = timeoutPolicy.timeout(for: key.placement)
+            if let adaptedTimeout = timeoutPolicy.adaptedTimeout(for: key.placement) {
+                let workItem = DispatchWorkItem { [weak self] in
+                    self?.timeOut(after: adaptedTimeout)
+                }
+                timeoutWorkItem = workItem
+                DispatchQueue.main.asyncAfter(deadline: .now() + adaptedTimeout, execute: workItem)
+            }
+        }
+        
+        // The hedge is scheduled after the latency percentile of the placement, if any.
+        if let hedgeDelay = hedgingPolicy?.adCallDidStart(for: key.placement) {
+            let workItem = DispatchWorkItem { [weak self] in
+                self?.hedge()
+            }
+            hedgeWorkItem = workItem
+            DispatchQueue.main.asyncAfter(deadline: .now() + hedgeDelay, execute: workItem)
+        }
+        
+        performAttempt()
+    }
+    
+    private func hedge() {
+        hedgeWorkItem = nil
+        guard hedgingPolicy?.requestHedge() == true else { return }
+        performAttempt()
+    }
+    
+    private func timeOut(after timeout: TimeInterval) {
+        timeoutWorkItem = nil
+        
+        // The attempts still running are cancelled: their result would come too late.
+        finish(.failure(SASAdCallTimeoutError(timeout: timeout)), hedgeDidWin: false)
+    }
+    
+    private func performAttempt() {
+        pendingAttempts += 1
+        adCalls.append(startAttempt(isHedge: !adCalls.isEmpty))
+    }
+    
+    /// Starts a new attempt with the loader. Implemented by subclasses.
+    func startAttempt(isHedge: Bool) -> SASAdCall {
+        fatalError("Implemented by subclasses")
+    }
+    
+    /// Cancels every attempt still running.
+    private func detach() {
+        hedgeWorkItem?.cancel()
+        hedgeWorkItem = nil
+        timeoutWorkItem?.cancel()
+        timeoutWorkItem = nil
+        
+        // The ad calls still running are abandoned, the loaded ad being retained by the coalesced ad.
+        adCalls.forEach { $0.cancel() }
+        adCalls = []
+    }
+    
+    func addWaiter(_ id: Int, _ block: @escaping Waiter) {
+        waiters.append((id, block))
+    }
+    
+    func removeWaiter(_ id: Int) {
+        guard let index = waiters.firstIndex(where: { $0.id == id }) else { return }
+        waiters.remove(at: index)
+        
+        // The ad call is abandoned when nobody is waiting for it anymore.
+        if waiters.isEmpty {
+            detach()
+            coalescer?.loadWasAbandoned(self)
+        }
+    }
+    
+    func attemptDidReturn<Ad: AnyObject>(_ result: Result<SASCoalescedAd<Ad>, any Error>, isHedge: Bool) {
+        switch result {
+        case .success(let ad):
+            finish(.success(ad), hedgeDidWin: isHedge)
+        case .failure(let error):
+            attemptDidFail(error)
+        }
+    }
+    
+    private func attemptDidFail(_ error: any Error) {
+        pendingAttempts -= 1
+        
+        // The load only fails once all its attempts have failed: a hedge is not started after a failure since the
+        // ad call has returned.
+        guard pendingAttempts == 0 else { return }
+        finish(.failure(error), hedgeDidWin: false)
+    }
+    
+    private func finish(_ result: Result<AnyObject, any Error>, hedgeDidWin: Bool) {
+        detach()
+        coalescer?.loadDidFinish(self)
+        
+        // The duration of the ad call is fed back to the policies so they adapt to the latency of the placement.
+        var succeeded = false
+        if case .success = result {
+            succeeded = true
+        }
+        let duration = CACurrentMediaTime() - startTime
+        timeoutPolicy?.recordAdCall(for: key.placement, duration: duration, timeout: appliedTimeout, succeeded: succeeded)
+        hedgingPolicy?.recordAdCall(for: key.placement, duration: duration, hedgeDidWin: hedgeDidWin)
+        
+        // The result is fanned out to every waiter, in the order they have been attached.
+        let waiters = self.waiters
+        self.waiters = []
+        waiters.forEach { $0.block(result) }
+    }
+    
+}
+
+private final class BannerLoad: InFlightLoad {
+    
+    override func startAttempt(isHedge: Bool) -> SASAdCall {
+        return loader.loadBannerView(with: adPlacement) { [weak self] result in
+            self?.attemptDidReturn(result.map { SASCoalescedAd(ad: $0.bannerView, adInfo: $0.adInfo) }, isHedge: isHedge)
+        }
+    }
+    
+}
+
+private final class InterstitialLoad: InFlightLoad {
+    
+    override func startAttempt(isHedge: Bool) -> SASAdCall {
+        return loader.loadInterstitial(with: adPlacement) { [weak self] result in
+            self?.attemptDidReturn(result.map { SASCoalescedAd(ad: $0.interstitialManager, adInfo: $0.adInfo) }, isHedge: isHedge)
+        }
+    }
+    
+}
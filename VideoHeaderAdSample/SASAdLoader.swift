@@ -0,0 +1,150 @@
+//
+//  SASAdLoader.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import UIKit
+import SASDisplayKit
+
+/**
+ An ad call started by a `SASAdLoader`, which can be cancelled if its result is not needed anymore.
+ */
+protocol SASAdCall: AnyObject {
+    /**
+     Cancels the ad call: its completion will not be called.
+     */
+    func cancel()
+}
+
+/**
+ Performs the ad calls of the `SASAdLoadCoalescer`.
+ 
+ `SASAdSDKLoader` performs them with the SDK. Another loader (for instance `SASAdServerSimulator` in the tests) can be injected
+ in the coalescer to test or benchmark the coalescer and its policies without any network access.
+ 
+ @note Loaders are only used from the main thread, and must call their completions asynchronously on the main thread.
+ */
+protocol SASAdLoader: AnyObject {
+    
+    typealias BannerCompletion = (Result<(bannerView: SASBannerView, adInfo: SASAdInfo), any Error>) -> Void
+    typealias InterstitialCompletion = (Result<(interstitialManager: SASInterstitialManager, adInfo: SASAdInfo), any Error>) -> Void
+    
+    /**
+     Performs an ad call for a banner.
+     
+     @param adPlacement The ad placement used to load the ad.
+     @param completion The block called with the loaded banner view and its ad info, or the loading error.
+     @return The ad call, which can be cancelled.
+     */
+    func loadBannerView(with adPlacement: SASAdPlacement, completion: @escaping BannerCompletion) -> SASAdCall
+    
+    /**
+     Performs an ad call for an interstitial.
+     
+     @param adPlacement The ad placement used to load the ad.
+     @param completion The block called with the loaded interstitial manager and its ad info, or the loading error.
+     @return The ad call, which can be cancelled.
+     */
+    func loadInterstitial(with adPlacement: SASAdPlacement, completion: @escaping InterstitialCompletion) -> SASAdCall
+    
+}
+
+/**
+ Loader performing the ad calls with the SDK: each ad call loads a new banner view or interstitial manager.
+ */
+final class SASAdSDKLoader: SASAdLoader {
+    
+    // MARK: - Shared instance
+    
+    /// The shared SDK loader, used by default by `SASAdLoadCoalescer`.
+    static let shared = SASAdSDKLoader()
+    
+    // MARK: - Loading API
+    
+    func loadBannerView(with adPlacement: SASAdPlacement, completion: @escaping BannerCompletion) -> SASAdCall {
+        let adCall = BannerCall(completion: completion)
+        adCall.bannerView.loadAd(with: adPlacement)
+        return adCall
+    }
+    
+    func loadInterstitial(with adPlacement: SASAdPlacement, completion: @escaping InterstitialCompletion) -> SASAdCall {
+        let adCall = InterstitialCall(adPlacement: adPlacement, completion: completion)
+        adCall.interstitialManager.loadAd()
+        return adCall
+    }
+    
+}
+
+// MARK: - SDK ad calls
+
+/**
+ Banner ad call performed with the SDK, acting as delegate of the banner view until the ad call returns.
+ 
+ The ad call is retained by the caller until it returns, since the banner view only keeps a weak reference on it.
+ */
+private final class BannerCall: NSObject, SASAdCall, SASBannerViewDelegate {
+    
+    let bannerView = SASBannerView(frame: .zero)
+    private var completion: SASAdLoader.BannerCompletion?
+    
+    init(completion: @escaping SASAdLoader.BannerCompletion) {
+        self.completion = completion
+        super.init()
+        bannerView.delegate = self
+    }
+    
+    func cancel() {
+        // The banner view stops reporting to the ad call, the loaded one being retained by its new owner if any.
+        completion = nil
+        bannerView.delegate = nil
+    }
+    
+    func bannerView(_ bannerView: SASBannerView, didLoadWith adInfo: SASAdInfo) {
+        let completion = self.completion
+        cancel()
+        completion?(.success((bannerView, adInfo)))
+    }
+    
+    func bannerView(_ bannerView: SASBannerView, didFailToLoad error: any Error) {
+        let completion = self.completion
+        cancel()
+        completion?(.failure(error))
+    }
+    
+}
+
+/**
+ Interstitial ad call performed with the SDK, acting as delegate of the interstitial manager until the ad call returns.
+ */
+private final class InterstitialCall: NSObject, SASAdCall, SASInterstitialManagerDelegate {
+    
+    let interstitialManager: SASInterstitialManager
+    private var completion: SASAdLoader.InterstitialCompletion?
+    
+    init(adPlacement: SASAdPlacement, completion: @escaping SASAdLoader.InterstitialCompletion) {
+        self.interstitialManager = SASInterstitialManager(adPlacement: adPlacement)
+        self.completion = completion
+        super.init()
+        interstitialManager.delegate = self
+    }
+    
+    func cancel() {
+        completion = nil
+        interstitialManager.delegate = nil
+    }
+    
+    func interstitialManager(_ interstitialManager: SASInterstitialManager, didLoadWith adInfo: SASAdInfo) {
+        let completion = self.completion
+        cancel()
+        completion?(.success((interstitialManager, adInfo)))
+    }
+    
+    func interstitialManager(_ interstitialManager: SASInterstitialManager, didFailToLoad error: any Error) {
+        let completion = self.completion
+        cancel()
+        completion?(.failure(error))
+    }
+    
+}
@@ -0,0 +1,269 @@
+//
+//  SASAdPlacementKey.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import Foundation
+import SASDisplayKit
+
+/**
+ Immutable and interned key identifying the full targeting of a `SASAdPlacement`.
+ 
+ `SASAdPlacement` is a reference type with mutable properties and without value equality: this key captures,
+ at creation time, every field that defines which ad will be returned for a placement (ids, keyword targeting,
+ seller-defined audiences and contents with their segments, supply chain object) so it can be used as a cache
+ or deduplication key.
+ 
+ The fields are serialized once into a canonical byte representation, from which a stable 64-bit hash is
+ computed. Keys are then interned: all keys with the same canonical bytes share the same storage, so equality
+ and hashing are O(1) whatever the number of segments.
+ 
+ Building a key is O(n) in the size of the targeting: `SASAdPlacement.placementKey` caches the key of a placement
+ until its targeting changes, so the lookups performed on each load do not rebuild it.
+ */
+struct SASAdPlacementKey: Hashable {
+    
+    // MARK: - Storage
+    
+    /// Interned storage of a key.
+    private final class Storage {
+        let bytes: [UInt8]
+        let hash64: UInt64
+        
+        init(bytes: [UInt8], hash64: UInt64) {
+            self.bytes = bytes
+            self.hash64 = hash64
+        }
+    }
+    
+    private let storage: Storage
+    
+    /// The canonical byte serialization of the placement targeting.
+    var canonicalBytes: [UInt8] {
+        return storage.bytes
+    }
+    
+    /// The stable 64-bit hash (FNV-1a) of the canonical bytes.
+    ///
+    /// Unlike `hashValue`, this hash does not change between launches and can be persisted.
+    var hash64: UInt64 {
+        return storage.hash64
+    }
+    
+    // MARK: - Initialization
+    
+    /**
+     Initialize a new key from the current state of an ad placement.
+     
+     @param adPlacement The ad placement whose targeting is captured by the key.
+     */
+    init(adPlacement: SASAdPlacement) {
+        var encoder = CanonicalEncoder()
+        encoder.encode(adPlacement.siteId)
+        encoder.encode(adPlacement.pageId)
+        encoder.encode(adPlacement.formatId)
+        encoder.encode(adPlacement.keywordTargeting)
+        encoder.encode(adPlacement.sellerDefinedAudiences) { encoder, audience in
+            encoder.encode(audience.id)
+            encoder.encode(audience.name)
+            encoder.encode(audience.segments)
+        }
+        encoder.encode(adPlacement.sellerDefinedContents) { encoder, content in
+            encoder.encode(content.id)
+            encoder.encode(content.name)
+            encoder.encode(content.segments)
+        }
+        encoder.encode(adPlacement.supplyChainObjectString)
+        
+        storage = SASAdPlacementKey.intern(bytes: encoder.bytes)
+    }
+    
+    // MARK: - Hashable
+    
+    static func == (lhs: SASAdPlacementKey, rhs: SASAdPlacementKey) -> Bool {
+        // Keys are interned: identical targetings always share the same storage.
+        return lhs.storage === rhs.storage
+    }
+    
+    func hash(into hasher: inout Hasher) {
+        hasher.combine(storage.hash64)
+    }
+    
+    // MARK: - Interning
+    
+    private final class WeakStorage {
+        weak var storage: Storage?
+        
+        init(_ storage: Storage) {
+            self.storage = storage
+        }
+    }
+    
+    /// Number of hashes in the intern table from which the released storages are pruned periodically.
+    private static let PRUNE_THRESHOLD = 1_024
+    
+    private static let internLock = NSLock()
+    private static var internTable = [UInt64: [WeakStorage]]()
+    private static var insertionsSincePrune = 0
+    
+    private static func intern(bytes: [UInt8]) -> Storage {
+        let hash64 = fnv1a(bytes)
+        
+        internLock.lock()
+        defer { internLock.unlock() }
+        
+        // Storages released since their interning are pruned from the bucket.
+        var bucket = internTable[hash64, default: []].filter { $0.storage != nil }
+        if let storage = bucket.lazy.compactMap({ $0.storage }).first(where: { $0.bytes == bytes }) {
+            internTable[hash64] = bucket
+            return storage
+        }
+        
+        let storage = Storage(bytes: bytes, hash64: hash64)
+        bucket.append(WeakStorage(storage))
+        internTable[hash64] = bucket
+        
+        // Released storages whose hash is never looked up again would stay in the table forever: the whole table
+        // is pruned once it is large enough, after as many insertions as half its size (so pruning is amortized O(1)).
+        insertionsSincePrune += 1
+        if internTable.count >= PRUNE_THRESHOLD && insertionsSincePrune >= internTable.count / 2 {
+            pruneInternTable()
+        }
+        return storage
+    }
+    
+    private static func pruneInternTable() {
+        internTable = internTable.compactMapValues { bucket in
+            let liveBucket = bucket.filter { $0.storage != nil }
+            return liveBucket.isEmpty ? nil : liveBucket
+        }
+        insertionsSincePrune = 0
+    }
+    
+    /// Number of hashes currently in the intern table (released storages included until they are pruned).
+    static var internedHashCount: Int {
+        internLock.lock()
+        defer { internLock.unlock() }
+        return internTable.count
+    }
+    
+    private static func fnv1a(_ bytes: [UInt8]) -> UInt64 {
+        var hash: UInt64 = 0xcbf29ce484222325
+        for byte in bytes {
+            hash ^= UInt64(byte)
+            hash = hash &* 0x100000001b3
+        }
+        return hash
+    }
+    
+}
+
+// MARK: - Cached key
+
+extension SASAdPlacement {
+    
+    private static var PLACEMENT_KEY_ASSOCIATION: UInt8 = 0
+    
+    /// Key paths of the mutable targeting properties captured by the key.
+    private static let TARGETING_KEY_PATHS = [
+        #keyPath(SASAdPlacement.keywordTargeting),
+        #keyPath(SASAdPlacement.sellerDefinedAudiences),
+        #keyPath(SASAdPlacement.sellerDefinedContents),
+        #keyPath(SASAdPlacement.supplyChainObjectString),
+    ]
+    
+    /**
+     The key of the placement, built on first use then cached on the placement until its targeting changes.
+     
+     Setting a targeting property stores a new object in the placement: the cached key is reused only while every
+     targeting property still holds the very object the key was built from, so a placement modified after its first
+     load always gets the key of its new targeting.
+     */
+    var placementKey: SASAdPlacementKey {
+        let targeting = SASAdPlacement.TARGETING_KEY_PATHS.map { value(forKey: $0).map { $0 as AnyObject } }
+        if let box = objc_getAssociatedObject(self, &SASAdPlacement.PLACEMENT_KEY_ASSOCIATION) as? SASAdPlacementKeyBox, box.isBuilt(from: targeting) {
+            return box.key
+        }
+        let key = SASAdPlacementKey(adPlacement: self)
+        objc_setAssociatedObject(self, &SASAdPlacement.PLACEMENT_KEY_ASSOCIATION, SASAdPlacementKeyBox(key, targeting: targeting), .OBJC_ASSOCIATION_RETAIN)
+        return key
+    }
+    
+}
+
+/// Reference wrapper allowing a key to be stored as an associated object, with the targeting it was built from.
+private final class SASAdPlacementKeyBox {
+    let key: SASAdPlacementKey
+    
+    /// The targeting objects, retained so their addresses cannot be reused by other objects.
+    private let targeting: [AnyObject?]
+    
+    init(_ key: SASAdPlacementKey, targeting: [AnyObject?]) {
+        self.key = key
+        self.targeting = targeting
+    }
+    
+    func isBuilt(from targeting: [AnyObject?]) -> Bool {
+        return self.targeting.count == targeting.count && zip(self.targeting, targeting).allSatisfy { $0 === $1 }
+    }
+}
+
+// MARK: - Canonical encoding
+
+/**
+ Encoder producing the canonical byte serialization of a placement.
+ 
+ Integers are encoded as 8 bytes little endian, optional values are prefixed by a presence byte, strings and
+ arrays by their length (varint), so two different targetings can never produce the same bytes.
+ */
+private struct CanonicalEncoder {
+    
+    private(set) var bytes = [UInt8]()
+    
+    mutating func encode(_ value: Int) {
+        withUnsafeBytes(of: Int64(value).littleEndian) { bytes.append(contentsOf: $0) }
+    }
+    
+    mutating func encode(_ value: String?) {
+        guard let value else {
+            bytes.append(0)
+            return
+        }
+        bytes.append(1)
+        let utf8 = value.utf8
+        encodeLength(utf8.count)
+        bytes.append(contentsOf: utf8)
+    }
+    
+    mutating func encode(_ segments: [SASSellerDefinedSegment]?) {
+        encode(segments) { encoder, segment in
+            encoder.encode(segment.id)
+            encoder.encode(segment.name)
+            encoder.encode(segment.value)
+        }
+    }
+    
+    mutating func encode<Element>(_ values: [Element]?, element: (inout CanonicalEncoder, Element) -> Void) {
+        guard let values else {
+            bytes.append(0)
+            return
+        }
+        bytes.append(1)
+        encodeLength(values.count)
+        for value in values {
+            element(&self, value)
+        }
+    }
+    
+    private mutating func encodeLength(_ length: Int) {
+        var value = UInt64(length)
+        while value >= 0x80 {
+            bytes.append(UInt8(value & 0x7f) | 0x80)
+            value >>= 7
+        }
+        bytes.append(UInt8(value))
+    }
+    
+}
@@ -0,0 +1,183 @@
+//
+//  SASAdPrefetchCache.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import UIKit
+import SASDisplayKit
+
+/**
+ Cache of banners loaded ahead of time.
+
+ The app can prefetch an ad placement before the screen displaying it is opened: the banner is then loaded
+ in the background and kept for a limited time (TTL). The `SASVideoHeaderAdCell` will adopt the ready banner
+ instead of performing its own ad call, removing the ad call round trip from the path to the first impression.
+
+ Prefetches are performed through a `SASAdLoadCoalescer`: an ad cell loading a placement whose prefetch is
+ still in flight is attached to it instead of performing a second ad call.
+
+ @note This class must only be used from the main thread.
+ */
+class SASAdPrefetchCache {
+    
+    // MARK: - Constants
+    
+    /// Default duration (in seconds) a prefetched ad is kept before being considered expired.
+    static let DEFAULT_TIME_TO_LIVE: TimeInterval = 120.0
+    
+    // MARK: - Shared instance
+    
+    /// The shared prefetch cache, used by default by `SASVideoHeaderAdCell`.
+    static let shared = SASAdPrefetchCache()
+    
+    // MARK: - Counters
+    
+    /// Counters describing the efficiency of the prefetch cache.
+    struct Counters: Equatable {
+        /// Number of ads requested from the cache and found ready.
+        var hits = 0
+        
+        /// Number of ads requested from the cache but not available (never prefetched, still loading, failed
+        /// or already claimed by another waiter of the same load).
+        var misses = 0
+        
+        /// Number of ads requested from the cache but discarded because their TTL was over.
+        var expirations = 0
+        
+        /// Number of prefetches started.
+        var prefetches = 0
+        
+        /// Number of prefetches that failed to load.
+        var failures = 0
+        
+        /// Number of ready ads evicted because another waiter of their load has claimed them.
+        var claimEvictions = 0
+    }
+    
+    // MARK: - Public properties
+    
+    /// Duration (in seconds) a prefetched ad is kept, starting when it has been loaded.
+    var timeToLive = SASAdPrefetchCache.DEFAULT_TIME_TO_LIVE
+    
+    /// Counters of the cache since its creation.
+    private(set) var counters = Counters()
+    
+    // MARK: - Private properties
+    
+    private enum Entry {
+        case loading(SASAdLoadCoalescer.Request)
+        case ready(SASCoalescedAd<SASBannerView>, loadTimestamp: TimeInterval)
+    }
+    
+    private let coalescer: SASAdLoadCoalescer
+    private var entries = [SASAdPlacementKey: Entry]()
+    
+    // MARK: - Initialization
+    
+    /**
+     Initialize a new instance of SASAdPrefetchCache.
+     
+     @param coalescer The coalescer used to perform the prefetches.
+     */
+    init(coalescer: SASAdLoadCoalescer = .shared) {
+        self.coalescer = coalescer
+    }
+    
+    // MARK: - Cache API
+    
+    /**
+     Starts loading an ad for the given placement, unless an ad is already loading or ready for it.
+     
+     @param adPlacement The ad placement to prefetch.
+     */
+    func prefetchAd(with adPlacement: SASAdPlacement) {
+        let key = adPlacement.placementKey
+        
+        // An expired or claimed entry is replaced, any other entry is kept as is.
+        if let entry = entries[key], isUsable(entry) {
+            return
+        }
+        
+        counters.prefetches += 1
+        let request = coalescer.loadBannerView(with: adPlacement) { [weak self] result in
+            guard let self else { return }
+            switch result {
+            case .success(let ad):
+                // The ad is now ready: its TTL starts now.
+                self.entries[key] = .ready(ad, loadTimestamp: ProcessInfo.processInfo.systemUptime)
+                
+                // If an ad cell attached to the same load claims the ad, the entry is evicted right away so the
+                // cache does not keep a banner displayed elsewhere alive.
+                ad.observeClaim { [weak self, weak ad] in
+                    guard let self, case .ready(let readyAd, _) = self.entries[key], readyAd === ad else { return }
+                    self.entries[key] = nil
+                    self.counters.claimEvictions += 1
+                }
+            case .failure:
+                // Failed prefetches are simply discarded: the ad cell will perform its own ad call.
+                self.entries[key] = nil
+                self.counters.failures += 1
+            }
+        }
+        entries[key] = .loading(request)
+    }
+    
+    /**
+     Returns the ready banner prefetched for the given placement, if any.
+     
+     The banner is claimed and removed from the cache: the caller becomes its owner and must set itself as
+     its delegate.
+     
+     @param adPlacement The ad placement of the ad.
+     @return The prefetched banner and its ad info, or nil if no valid ad is ready for this placement.
+     */
+    func takeAd(for adPlacement: SASAdPlacement) -> (bannerView: SASBannerView, adInfo: SASAdInfo)? {
+        let key = adPlacement.placementKey
+        
+        guard case .ready(let ad, let loadTimestamp) = entries[key] else {
+            counters.misses += 1
+            return nil
+        }
+        
+        entries[key] = nil
+        
+        guard ProcessInfo.processInfo.systemUptime - loadTimestamp <= timeToLive else {
+            counters.expirations += 1
+            return nil
+        }
+        
+        guard ad.claim() else {
+            counters.misses += 1
+            return nil
+        }
+        
+        counters.hits += 1
+        return (ad.ad, ad.adInfo)
+    }
+    
+    /**
+     Removes every prefetched ad from the cache and cancels the prefetches in flight.
+     */
+    func removeAll() {
+        entries.values.forEach {
+            if case .loading(let request) = $0 {
+                request.cancel()
+            }
+        }
+        entries.removeAll()
+    }
+    
+    // MARK: - Internal logic
+    
+    private func isUsable(_ entry: Entry) -> Bool {
+        switch entry {
+        case .loading:
+            return true
+        case .ready(let ad, let loadTimestamp):
+            return !ad.isClaimed && ProcessInfo.processInfo.systemUptime - loadTimestamp <= timeToLive
+        }
+    }
+    
+}
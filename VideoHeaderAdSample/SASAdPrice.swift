@@ -0,0 +1,383 @@
+//
+//  SASAdPrice.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import Foundation
+
+/**
+ Exact fixed-point price, for instance the CPM delivered as a string in
+ `SASAdProgrammaticInfo.clearedPricePublisherCurrency`.
+ 
+ The price is stored as an integer number of millionths of a currency unit: it can be parsed without allocation,
+ compared and summed exactly, unlike `Double` (inexact) or `Decimal(string:)` and `NumberFormatter` (allocating and
+ locale-sensitive).
+ */
+struct SASAdPrice: Hashable, Comparable {
+    
+    // MARK: - Constants
+    
+    /// Number of fraction digits kept by a price.
+    static let FRACTION_DIGITS = 6
+    
+    /// Number of micro units in a currency unit.
+    static let SCALE: Int64 = 1_000_000
+    
+    static let zero = SASAdPrice(microUnits: 0)
+    
+    private static let POWERS_OF_TEN: [Int64] = [1, 10, 100, 1_000, 10_000, 100_000, 1_000_000]
+    
+    // MARK: - Properties
+    
+    /// The price in millionths of a currency unit.
+    let microUnits: Int64
+    
+    /// The price as a `Decimal`, exact.
+    var decimalValue: Decimal {
+        return Decimal(microUnits) / Decimal(SASAdPrice.SCALE)
+    }
+    
+    /// The price as a `Double`, rounded to the nearest representable value.
+    var doubleValue: Double {
+        return Double(microUnits) / Double(SASAdPrice.SCALE)
+    }
+    
+    // MARK: - Initialization
+    
+    init(microUnits: Int64) {
+        self.microUnits = microUnits
+    }
+    
+    /**
+     Parses a price formatted with a dot as decimal separator whatever the locale, like the prices delivered by the
+     ad server ('12', '0.35', '.5').
+     
+     Fraction digits beyond the sixth one are rounded half up. Signs, exponents, spaces and grouping separators are
+     rejected, as well as prices too large to be represented.
+     
+     @param string The string to parse.
+     @return The parsed price, or nil if the string is not a valid price.
+     */
+    init?(_ string: some StringProtocol) {
+        // The UTF-8 bytes are read in place when the string is stored contiguously (native strings), and iterated
+        // otherwise (strings bridged from the SDK), without allocating in both cases.
+        let parsedPrice = string.utf8.withContiguousStorageIfAvailable { SASAdPrice.parse(utf8: $0) } ?? SASAdPrice.parse(utf8: string.utf8)
+        guard let parsedPrice else { return nil }
+        self = parsedPrice
+    }
+    
+    // MARK: - Parsing
+    
+    /**
+     Parses a price from its UTF-8 bytes (see `init?(_:)` for the accepted format).
+     
+     @param bytes The UTF-8 bytes of the price.
+     @return The parsed price, or nil if the bytes are not a valid price.
+     */
+    static func parse<Bytes: Sequence<UInt8>>(utf8 bytes: Bytes) -> SASAdPrice? {
+        var integerPart: Int64 = 0
+        var fractionPart: Int64 = 0
+        var fractionDigits = 0
+        var digits = 0
+        var isInFraction = false
+        var roundsUp = false
+        
+        for byte in bytes {
+            switch byte {
+            case UInt8(ascii: "0")...UInt8(ascii: "9"):
+                let digit = Int64(byte &- UInt8(ascii: "0"))
+                digits += 1
+                
+                if !isInFraction {
+                    let (shiftedPart, shiftOverflow) = integerPart.multipliedReportingOverflow(by: 10)
+                    let (newPart, addOverflow) = shiftedPart.addingReportingOverflow(digit)
+                    guard !shiftOverflow, !addOverflow else { return nil }
+                    integerPart = newPart
+                } else if fractionDigits < FRACTION_DIGITS {
+                    fractionPart = fractionPart * 10 + digit
+                    fractionDigits += 1
+                } else if fractionDigits == FRACTION_DIGITS {
+                    // Only the first extra digit matters to round half up, the next ones are ignored.
+                    roundsUp = digit >= 5
+                    fractionDigits += 1
+                }
+            case UInt8(ascii: "."):
+                guard !isInFraction else { return nil }
+                isInFraction = true
+            default:
+                return nil
+            }
+        }
+        guard digits > 0 else { return nil }
+        
+        let keptFractionDigits = min(fractionDigits, FRACTION_DIGITS)
+        let fraction = fractionPart * POWERS_OF_TEN[FRACTION_DIGITS - keptFractionDigits] + (roundsUp ? 1 : 0)
+        let (scaledPart, scaleOverflow) = integerPart.multipliedReportingOverflow(by: SCALE)
+        let (microUnits, addOverflow) = scaledPart.addingReportingOverflow(fraction)
+        guard !scaleOverflow, !addOverflow else { return nil }
+        return SASAdPrice(microUnits: microUnits)
+    }
+    
+    // MARK: - Comparable
+    
+    static func < (lhs: SASAdPrice, rhs: SASAdPrice) -> Bool {
+        return lhs.microUnits < rhs.microUnits
+    }
+    
+}
+
+// MARK: - Currencies
+
+/**
+ ISO 4217 currency, stored as its three letters packed in an integer so it can be parsed, compared and hashed
+ without allocation.
+ */
+struct SASCurrency: Hashable, CustomStringConvertible {
+    
+    // MARK: - Constants
+    
+    static let EUR = SASCurrency(packedCode: SASCurrency.pack("EUR")!)
+    static let USD = SASCurrency(packedCode: SASCurrency.pack("USD")!)
+    static let GBP = SASCurrency(packedCode: SASCurrency.pack("GBP")!)
+    
+    /// The active ISO 4217 currency codes, packed and sorted.
+    private static let KNOWN_CODES: [UInt32] = """
+        AED AFN ALL AMD ANG AOA ARS AUD AWG AZN BAM BBD BDT BGN BHD BIF BMD BND BOB BRL BSD BTN BWP BYN BZD CAD CDF \
+        CHF CLP CNY COP CRC CUP CVE CZK DJF DKK DOP DZD EGP ERN ETB EUR FJD FKP GBP GEL GHS GIP GMD GNF GTQ GYD HKD \
+        HNL HTG HUF IDR ILS INR IQD IRR ISK JMD JOD JPY KES KGS KHR KMF KPW KRW KWD KYD KZT LAK LBP LKR LRD LSL LYD \
+        MAD MDL MGA MKD MMK MNT MOP MRU MUR MVR MWK MXN MYR MZN NAD NGN NIO NOK NPR NZD OMR PAB PEN PGK PHP PKR PLN \
+        PYG QAR RON RSD RUB RWF SAR SBD SCR SDG SEK SGD SHP SLE SOS SRD SSP STN SVC SYP SZL THB TJS TMT TND TOP TRY \
+        TTD TWD TZS UAH UGX USD UYU UZS VES VND VUV WST XAF XCD XOF XPF YER ZAR ZMW ZWG
+        """.split(separator: " ").map { SASCurrency.pack($0)! }.sorted()
+        
+    // MARK: - Properties
+    
+    /// The three uppercase ASCII letters of the currency code, packed from the most significant byte.
+    let packedCode: UInt32
+    
+    /// The currency code ('EUR', 'USD', …).
+    var code: String {
+        let bytes = [UInt8(truncatingIfNeeded: packedCode >> 16), UInt8(truncatingIfNeeded: packedCode >> 8), UInt8(truncatingIfNeeded: packedCode)]
+        return String(decoding: bytes, as: UTF8.self)
+    }
+    
+    var description: String {
+        return code
+    }
+    
+    // MARK: - Initialization
+    
+    private init(packedCode: UInt32) {
+        self.packedCode = packedCode
+    }
+    
+    /**
+     Initialize a currency from its ISO 4217 code, case insensitive.
+     
+     @param code The currency code.
+     @return The currency, or nil if the code is not an active ISO 4217 currency code.
+     */
+    init?(code: some StringProtocol) {
+        guard let packedCode = SASCurrency.pack(code), SASCurrency.isKnown(packedCode) else { return nil }
+        self.packedCode = packedCode
+    }
+    
+    // MARK: - Private methods
+    
+    private static func pack(_ code: some StringProtocol) -> UInt32? {
+        var packedCode: UInt32 = 0
+        var length = 0
+        for byte in code.utf8 {
+            let uppercasedByte: UInt8
+            switch byte {
+            case UInt8(ascii: "A")...UInt8(ascii: "Z"):
+                uppercasedByte = byte
+            case UInt8(ascii: "a")...UInt8(ascii: "z"):
+                uppercasedByte = byte &- 0x20
+            default:
+                return nil
+            }
+            length += 1
+            guard length <= 3 else { return nil }
+            packedCode = packedCode << 8 | UInt32(uppercasedByte)
+        }
+        return length == 3 ? packedCode : nil
+    }
+    
+    private static func isKnown(_ packedCode: UInt32) -> Bool {
+        // Binary search in the sorted table of the known codes.
+        var lowerBound = 0
+        var upperBound = KNOWN_CODES.count
+        while lowerBound < upperBound {
+            let middle = (lowerBound + upperBound) / 2
+            if KNOWN_CODES[middle] < packedCode {
+                lowerBound = middle + 1
+            } else {
+                upperBound = middle
+            }
+        }
+        return lowerBound < KNOWN_CODES.count && KNOWN_CODES[lowerBound] == packedCode
+    }
+    
+}
+
+// MARK: - Currency conversion
+
+/**
+ Converter of prices to a reporting currency, exact to the micro unit (rounded half up).
+ 
+ Records are converted in batches: consecutive records in the same currency (the usual case, records being
+ grouped by publisher) are converted with SIMD vectors, the records of a run whose products may overflow being
+ converted one by one with full width arithmetic. Both paths return the same prices.
+ */
+struct SASAdPriceConverter {
+    
+    // MARK: - Types
+    
+    /// A price in a given currency.
+    struct Record: Hashable {
+        var price: SASAdPrice
+        var currency: SASCurrency
+    }
+    
+    private typealias Vector = SIMD8<Int64>
+    private static let VECTOR_LANE_COUNT = 8
+    
+    // MARK: - Properties
+    
+    /// The currency in which prices are converted.
+    let reportingCurrency: SASCurrency
+    
+    /// Value of one unit of each currency in the reporting currency (the rate of the reporting currency being 1).
+    private(set) var exchangeRates = [SASCurrency: SASAdPrice]()
+    
+    // MARK: - Initialization
+    
+    /**
+     Initialize a new converter.
+     
+     @param reportingCurrency The currency in which prices are converted.
+     @param exchangeRates Value of one unit of each currency in the reporting currency.
+     */
+    init(reportingCurrency: SASCurrency, exchangeRates: [SASCurrency: SASAdPrice] = [:]) {
+        self.reportingCurrency = reportingCurrency
+        exchangeRates.forEach { setExchangeRate($0.value, for: $0.key) }
+    }
+    
+    // MARK: - Public API
+    
+    /**
+     Sets the exchange rate of a currency.
+     
+     @param rate Value of one unit of the currency in the reporting currency. Negative rates are ignored.
+     @param currency The currency.
+     */
+    mutating func setExchangeRate(_ rate: SASAdPrice, for currency: SASCurrency) {
+        guard currency != reportingCurrency, rate.microUnits >= 0 else { return }
+        exchangeRates[currency] = rate
+    }
+    
+    /**
+     Converts a price to the reporting currency.
+     
+     @param price The price to convert.
+     @param currency The currency of the price.
+     @return The converted price, or nil if the currency has no exchange rate, if the price is negative or if the
+     converted price cannot be represented.
+     */
+    func convert(_ price: SASAdPrice, from currency: SASCurrency) -> SASAdPrice? {
+        guard let rate = rate(for: currency) else { return nil }
+        return SASAdPriceConverter.convert(price.microUnits, rate: rate).map(SASAdPrice.init(microUnits:))
+    }
+    
+    /**
+     Converts a batch of records to the reporting currency.
+     
+     @param records The records to convert.
+     @param vectorized Whether runs of records in the same currency are converted with SIMD vectors. The result is
+     the same in both cases: disable it to measure the gain.
+     @return The converted price of each record, nil if it cannot be converted (see `convert(_:from:)`).
+     */
+    func convert(_ records: [Record], vectorized: Bool = true) -> [SASAdPrice?] {
+        var convertedPrices = [SASAdPrice?](repeating: nil, count: records.count)
+        records.withUnsafeBufferPointer { records in
+            convertedPrices.withUnsafeMutableBufferPointer { convertedPrices in
+                var runStart = 0
+                while runStart < records.count {
+                    // The rate is looked up once per run of records in the same currency.
+                    let currency = records[runStart].currency
+                    var runEnd = runStart + 1
+                    while runEnd < records.count, records[runEnd].currency == currency {
+                        runEnd += 1
+                    }
+                    
+                    if let rate = rate(for: currency) {
+                        let run = runStart..<runEnd
+                        if vectorized {
+                            SASAdPriceConverter.convertVectorized(records, run: run, rate: rate, into: convertedPrices)
+                        } else {
+                            SASAdPriceConverter.convertSequentially(records, run: run, rate: rate, into: convertedPrices)
+                        }
+                    }
+                    runStart = runEnd
+                }
+            }
+        }
+        return convertedPrices
+    }
+    
+    // MARK: - Private methods
+    
+    private func rate(for currency: SASCurrency) -> Int64? {
+        return currency == reportingCurrency ? SASAdPrice.SCALE : exchangeRates[currency]?.microUnits
+    }
+    
+    /// Returns `microUnits * rate / SCALE` rounded half up, computed on 128 bits so it never overflows midway.
+    private static func convert(_ microUnits: Int64, rate: Int64) -> Int64? {
+        guard microUnits >= 0 else { return nil }
+        
+        let (high, low) = microUnits.multipliedFullWidth(by: rate)
+        
+        // The quotient only fits in 63 bits if the high part of the product is small enough.
+        guard high < SASAdPrice.SCALE / 2 else { return nil }
+        let (quotient, remainder) = SASAdPrice.SCALE.dividingFullWidth((high: high, low: low))
+        return remainder >= SASAdPrice.SCALE / 2 ? quotient + 1 : quotient
+    }
+    
+    private static func convertSequentially(_ records: UnsafeBufferPointer<Record>, run: Range<Int>, rate: Int64, into convertedPrices: UnsafeMutableBufferPointer<SASAdPrice?>) {
+        for index in run {
+            convertedPrices[index] = convert(records[index].price.microUnits, rate: rate).map(SASAdPrice.init(microUnits:))
+        }
+    }
+    
+    private static func convertVectorized(_ records: UnsafeBufferPointer<Record>, run: Range<Int>, rate: Int64, into convertedPrices: UnsafeMutableBufferPointer<SASAdPrice?>) {
+        // Prices up to this limit can be converted on 64 bits without overflowing.
+        let halfScale = SASAdPrice.SCALE / 2
+        let limit = rate > 0 ? (Int64.max - halfScale) / rate : Int64.max
+        
+        var index = run.lowerBound
+        while index + VECTOR_LANE_COUNT <= run.upperBound {
+            var prices = Vector()
+            for lane in 0..<VECTOR_LANE_COUNT {
+                prices[lane] = records[index + lane].price.microUnits
+            }
+            
+            if any(prices .< 0 .| prices .> limit) {
+                // At least one price of the vector needs the full width path.
+                convertSequentially(records, run: index..<(index + VECTOR_LANE_COUNT), rate: rate, into: convertedPrices)
+            } else {
+                let converted = (prices &* rate &+ halfScale) / SASAdPrice.SCALE
+                for lane in 0..<VECTOR_LANE_COUNT {
+                    convertedPrices[index + lane] = SASAdPrice(microUnits: converted[lane])
+                }
+            }
+            index += VECTOR_LANE_COUNT
+        }
+        
+        // The remaining records of the run do not fill a vector.
+        convertSequentially(records, run: index..<run.upperBound, rate: rate, into: convertedPrices)
+    }
+    
+}
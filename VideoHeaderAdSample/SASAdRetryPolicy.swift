@@ -0,0 +1,216 @@
+//
+//  SASAdRetryPolicy.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import Foundation
+import SASDisplayKit
+
+/**
+ Retry policy of the failed ad loads.
+ 
+ A failed ad load is retried after an exponential backoff with jitter, depending on the class of its error (a timeout
+ or a network failure is worth retrying, an unknown error is not). A retry is only scheduled if it can still return before the display
+ deadline of the ad (the time after which the ad would not be displayed above the fold anymore), and if the retry
+ budget shared by all the loads allows it.
+ 
+ @note This class must only be used from the main thread.
+ */
+final class SASAdRetryPolicy {
+    
+    // MARK: - Shared instance
+    
+    /// The shared retry policy, used by default by `SASVideoHeaderAdCell`.
+    static let shared = SASAdRetryPolicy()
+    
+    // MARK: - Types
+    
+    /// Class of a loading error, each class having its own backoff.
+    enum ErrorClass: CaseIterable {
+        /// The ad call has timed out (adapted timeout of the placement or network timeout).
+        case timeout
+        
+        /// The ad call has failed because of the network (connection lost, DNS failure, …).
+        case network
+        
+        /// Any other error, including every error of the SDK (no ad, invalid response, ad rendering, …).
+        case other
+    }
+    
+    /// Exponential backoff applied to the retries of an error class.
+    struct Backoff: Equatable {
+        /// Highest number of retries of a load (0 to never retry).
+        var maximumRetries: Int
+        
+        /// Delay (in seconds) before the first retry.
+        var initialDelay: TimeInterval
+        
+        /// Highest delay (in seconds) before a retry.
+        var maximumDelay: TimeInterval
+        
+        /// Factor applied to the delay after each retry.
+        var multiplier = 2.0
+        
+        /// No retry at all.
+        static let never = Backoff(maximumRetries: 0, initialDelay: 0.0, maximumDelay: 0.0)
+        
+        /**
+         Returns the delay before a retry, with 'equal jitter': half of the delay is fixed, the other half is random,
+         so concurrent loads failing at the same time do not retry at the same time.
+         
+         @param retry The index of the retry (starting at 0).
+         */
+        func delay(forRetry retry: Int, using generator: inout some RandomNumberGenerator) -> TimeInterval {
+            let delay = min(initialDelay * pow(multiplier, Double(retry)), maximumDelay)
+            return delay / 2.0 + Double.random(in: 0.0...(delay / 2.0), using: &generator)
+        }
+    }
+    
+    /// Configuration of the retry policy.
+    struct Configuration: Equatable {
+        /// Backoff of each error class.
+        var backoffs: [ErrorClass: Backoff] = [
+            .timeout: Backoff(maximumRetries: 2, initialDelay: 0.25, maximumDelay: 2.0),
+            .network: Backoff(maximumRetries: 3, initialDelay: 0.5, maximumDelay: 4.0),
+            .other: .never,
+        ]
+        
+        /// Time (in seconds) after the first ad call of a load after which the ad would not be displayed above the fold
+        /// anymore: no retry can be scheduled after this deadline.
+        var displayDeadline: TimeInterval = 5.0
+        
+        /// Minimum time (in seconds) a retry needs to return an ad, used to check that a retry can still return
+        /// before the display deadline.
+        var minimumAttemptDuration: TimeInterval = 1.0
+        
+        /// Number of retries allowed per load, on average (0.2 means that at most 20% extra ad calls are performed).
+        var budgetRatio = 0.2
+        
+        /// Highest number of retries which can be performed in a row when the budget has been saved up.
+        var maximumBurst = 10.0
+    }
+    
+    /// Decision taken for a failed load.
+    enum Decision: Equatable {
+        /// The load must be retried after the given delay (in seconds).
+        case retry(after: TimeInterval)
+        
+        /// The load must not be retried: the error class is not retried or its retries are exhausted.
+        case giveUp
+        
+        /// The load cannot be retried without missing its display deadline.
+        case deadlineExceeded
+        
+        /// The load cannot be retried because the retry budget is exhausted.
+        case budgetExhausted
+    }
+    
+    /// Counters describing the retry activity.
+    struct Counters: Equatable {
+        /// Number of retries scheduled.
+        var retries = 0
+        
+        /// Number of failed loads not retried because of their error class or because their retries were exhausted.
+        var giveUps = 0
+        
+        /// Number of failed loads not retried because of their display deadline.
+        var deadlineExceeded = 0
+        
+        /// Number of failed loads not retried because of the retry budget.
+        var budgetDenials = 0
+    }
+    
+    // MARK: - Properties
+    
+    /// The configuration of the retry policy.
+    let configuration: Configuration
+    
+    /// Counters of the policy since its creation.
+    private(set) var counters = Counters()
+    
+    // MARK: - Private properties
+    
+    /// The retry budget: each load earns `budgetRatio` token, each retry spends one.
+    private var budget: SASTokenBucket
+    
+    // MARK: - Initialization
+    
+    /**
+     Initialize a new retry policy.
+     
+     @param configuration The configuration of the retry policy.
+     */
+    init(configuration: Configuration = Configuration()) {
+        self.configuration = configuration
+        self.budget = SASTokenBucket(ratio: configuration.budgetRatio, maximumBurst: configuration.maximumBurst)
+    }
+    
+    // MARK: - Public API
+    
+    /**
+     Returns the class of a loading error.
+     
+     The SDK does not document the domains and codes of its errors: only the adapted timeouts of the placements and the
+     errors of the URL loading system are classified, any other error is classified as `other` so it is never mistaken
+     for a timeout.
+     */
+    static func errorClass(of error: any Error) -> ErrorClass {
+        if error is SASAdCallTimeoutError {
+            return .timeout
+        }
+        
+        let error = error as NSError
+        switch error.domain {
+        case NSURLErrorDomain:
+            return error.code == NSURLErrorTimedOut ? .timeout : .network
+        default:
+            return .other
+        }
+    }
+    
+    /**
+     Must be called when a new load starts (not for its retries), so it earns its share of the retry budget.
+     */
+    func loadDidStart() {
+        budget.adCallDidStart()
+    }
+    
+    /**
+     Decides whether a failed load must be retried.
+     
+     @param error The loading error.
+     @param retry The number of retries already performed for this load.
+     @param elapsedTime The time (in seconds) elapsed since the first ad call of this load.
+     @return The decision, a retry spending the retry budget.
+     */
+    func decision(after error: any Error, retry: Int, elapsedTime: TimeInterval) -> Decision {
+        var generator = SystemRandomNumberGenerator()
+        return decision(after: SASAdRetryPolicy.errorClass(of: error), retry: retry, elapsedTime: elapsedTime, using: &generator)
+    }
+    
+    /// Decides whether a failed load must be retried, using the given random generator for the jitter (so a
+    /// simulation can be replayed).
+    func decision(after errorClass: ErrorClass, retry: Int, elapsedTime: TimeInterval, using generator: inout some RandomNumberGenerator) -> Decision {
+        guard let backoff = configuration.backoffs[errorClass], retry < backoff.maximumRetries else {
+            counters.giveUps += 1
+            return .giveUp
+        }
+        
+        let delay = backoff.delay(forRetry: retry, using: &generator)
+        guard elapsedTime + delay + configuration.minimumAttemptDuration <= configuration.displayDeadline else {
+            counters.deadlineExceeded += 1
+            return .deadlineExceeded
+        }
+        
+        guard budget.spend() else {
+            counters.budgetDenials += 1
+            return .budgetExhausted
+        }
+        
+        counters.retries += 1
+        return .retry(after: delay)
+    }
+    
+}
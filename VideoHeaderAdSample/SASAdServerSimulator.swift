@@ -0,0 +1,312 @@
+//
+//  SASAdServerSimulator.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import Foundation
+
+/**
+ Local stand-in for the ad server, used to measure the ad loading logic without any network access.
+ 
+ The simulator answers ad calls after a latency drawn from a configurable distribution, with configurable
+ error, no-fill and slow body rates. It uses a seeded random generator, so a simulation is reproducible and can run
+ offline. The simulator only depends on Foundation: it can also perform the ad calls of `SASAdLoadCoalescer` (see
+ `SASAdServerSimulatorLoader.swift`), to measure the real loading logic and its policies against it.
+ */
+final class SASAdServerSimulator {
+    
+    // MARK: - Types
+    
+    /// Distribution of the latency of the simulated ad calls (in seconds).
+    enum LatencyDistribution {
+        /// Always the same latency.
+        case constant(TimeInterval)
+        
+        /// A latency uniformly distributed between two bounds.
+        case uniform(TimeInterval, TimeInterval)
+        
+        /// A log-normal latency, defined by its median and the standard deviation of its logarithm.
+        case logNormal(median: TimeInterval, sigma: Double)
+        
+        /// A heavy-tailed (Pareto) latency, defined by its minimum and its shape (the lower, the heavier the tail).
+        case pareto(minimum: TimeInterval, shape: Double)
+        
+        fileprivate func sample(using generator: inout SeededRandomNumberGenerator) -> TimeInterval {
+            switch self {
+            case .constant(let latency):
+                return latency
+            case .uniform(let lowerBound, let upperBound):
+                return TimeInterval.random(in: lowerBound...upperBound, using: &generator)
+            case .logNormal(let median, let sigma):
+                // Box-Muller transform to get a standard normal value.
+                let u1 = Double.random(in: Double.ulpOfOne..<1.0, using: &generator)
+                let u2 = Double.random(in: 0.0..<1.0, using: &generator)
+                let normal = (-2.0 * log(u1)).squareRoot() * cos(2.0 * Double.pi * u2)
+                return median * exp(sigma * normal)
+            case .pareto(let minimum, let shape):
+                let u = Double.random(in: Double.ulpOfOne..<1.0, using: &generator)
+                return minimum / pow(u, 1.0 / shape)
+            }
+        }
+    }
+    
+    /// Outcome of a simulated ad call.
+    enum Outcome: Equatable {
+        /// An ad has been returned.
+        case ad
+        
+        /// No ad is available for the placement.
+        case noFill
+        
+        /// The ad call failed (server or network error).
+        case error
+        
+        /// The ad call took longer than the timeout.
+        case timeout
+    }
+    
+    /// Profile of the simulated ad server.
+    struct Profile {
+        /// Latency of the ad call, until the response headers are received.
+        var latency = LatencyDistribution.logNormal(median: 0.25, sigma: 0.5)
+        
+        /// Probability of an ad call to fail.
+        var errorRate = 0.0
+        
+        /// Probability of an ad call to return no ad.
+        var noFillRate = 0.0
+        
+        /// Probability of an ad call to have a slow body, whose transfer adds `slowBodyLatency`.
+        var slowBodyRate = 0.0
+        
+        /// Additional latency of the slow bodies.
+        var slowBodyLatency = LatencyDistribution.uniform(1.0, 3.0)
+        
+        /// Probability of an ad call to start a burst of errors, during which the next `errorBurstLength` ad calls
+        /// fail (for instance a network outage or an overloaded server).
+        var errorBurstRate = 0.0
+        
+        /// Number of ad calls failing during a burst of errors.
+        var errorBurstLength = 5
+    }
+    
+    /// A simulated ad call, as drawn by the simulator.
+    struct Response: Equatable {
+        /// The outcome of the ad call.
+        let outcome: Outcome
+        
+        /// The time (in seconds) after which the outcome is known.
+        let duration: TimeInterval
+    }
+    
+    // MARK: - Properties
+    
+    /// The profile of the simulated ad server.
+    var profile: Profile
+    
+    /// Number of ad calls drawn by the simulator since its creation.
+    var adCallCount: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return drawnResponses
+    }
+    
+    private var drawnResponses = 0
+    private var generator: SeededRandomNumberGenerator
+    private var remainingBurstErrors = 0
+    private let lock = NSLock()
+    
+    // MARK: - Initialization
+    
+    /**
+     Initialize a new ad server simulator.
+     
+     @param profile The profile of the simulated ad server.
+     @param seed The seed of the random generator, so a simulation can be replayed.
+     */
+    init(profile: Profile = Profile(), seed: UInt64 = 0) {
+        self.profile = profile
+        self.generator = SeededRandomNumberGenerator(seed: seed)
+    }
+    
+    // MARK: - Simulation
+    
+    /**
+     Draws the response of an ad call, without waiting.
+     
+     @param timeout The ad call timeout (in seconds), if any.
+     @return The simulated response.
+     */
+    func drawResponse(timeout: TimeInterval? = nil) -> Response {
+        lock.lock()
+        defer { lock.unlock() }
+        
+        drawnResponses += 1
+        var duration = profile.latency.sample(using: &generator)
+        let draw = Double.random(in: 0.0..<1.0, using: &generator)
+        
+        if remainingBurstErrors == 0, profile.errorBurstRate > 0.0, Double.random(in: 0.0..<1.0, using: &generator) < profile.errorBurstRate {
+            remainingBurstErrors = profile.errorBurstLength
+        }
+        
+        let outcome: Outcome
+        if remainingBurstErrors > 0 {
+            remainingBurstErrors -= 1
+            outcome = .error
+        } else if draw < profile.errorRate {
+            outcome = .error
+        } else if draw < profile.errorRate + profile.noFillRate {
+            outcome = .noFill
+        } else {
+            outcome = .ad
+            if Double.random(in: 0.0..<1.0, using: &generator) < profile.slowBodyRate {
+                duration += profile.slowBodyLatency.sample(using: &generator)
+            }
+        }
+        
+        if let timeout, duration > timeout {
+            return Response(outcome: .timeout, duration: timeout)
+        }
+        return Response(outcome: outcome, duration: duration)
+    }
+    
+    /**
+     Performs a simulated ad call: the completion is called on the given queue once the simulated duration
+     has elapsed.
+     
+     @param timeout The ad call timeout (in seconds), if any.
+     @param queue The queue on which the completion is called.
+     @param completion The block called with the simulated response.
+     */
+    func requestAd(timeout: TimeInterval? = nil, queue: DispatchQueue = .main, completion: @escaping (Response) -> Void) {
+        let response = drawResponse(timeout: timeout)
+        queue.asyncAfter(deadline: .now() + response.duration) {
+            completion(response)
+        }
+    }
+    
+}
+
+// MARK: - Load generator
+
+/**
+ Load generator driving many concurrent simulated ad calls and reporting their latency percentiles.
+ */
+struct SASAdLoadGenerator {
+    
+    /// Latency percentiles (in seconds) of a set of ad calls.
+    struct Percentiles: Equatable {
+        var count = 0
+        var p50: TimeInterval = 0.0
+        var p95: TimeInterval = 0.0
+        var p99: TimeInterval = 0.0
+        
+        init(_ durations: [TimeInterval]) {
+            guard !durations.isEmpty else { return }
+            let sorted = durations.sorted()
+            count = sorted.count
+            p50 = Percentiles.percentile(0.50, of: sorted)
+            p95 = Percentiles.percentile(0.95, of: sorted)
+            p99 = Percentiles.percentile(0.99, of: sorted)
+        }
+        
+        static func percentile(_ percentile: Double, of sorted: [TimeInterval]) -> TimeInterval {
+            let index = Int((percentile * Double(sorted.count - 1)).rounded())
+            return sorted[index]
+        }
+    }
+    
+    /// Report of a load generation.
+    struct Report: Equatable {
+        /// Time-to-'didLoad' of the ad calls returning an ad.
+        var didLoad: Percentiles
+        
+        /// Time-to-'didFailToLoad' of the ad calls failing (error, no-fill or timeout).
+        var didFailToLoad: Percentiles
+        
+        /// Number of ad calls per outcome.
+        var outcomes: [SASAdServerSimulator.Outcome: Int]
+        
+        /// Ratio of ad calls returning an ad.
+        var fillRate: Double {
+            let total = outcomes.values.reduce(0, +)
+            return total > 0 ? Double(outcomes[.ad, default: 0]) / Double(total) : 0.0
+        }
+    }
+    
+    /// The simulated ad server.
+    let server: SASAdServerSimulator
+    
+    /**
+     Runs the given number of ad calls in virtual time and reports their latency.
+     
+     Ad calls do not wait for their simulated duration, so millions of them can be simulated in a few seconds.
+     
+     @param count The number of ad calls.
+     @param timeout The ad call timeout (in seconds), if any.
+     @return The report of the ad calls.
+     */
+    func run(count: Int, timeout: TimeInterval? = nil) -> Report {
+        return report(from: (0..<count).map { _ in server.drawResponse(timeout: timeout) })
+    }
+    
+    /**
+     Runs the given number of ad calls in virtual time, one after the other, with a timeout which can change between
+     two ad calls (for instance a timeout adapted from the previous responses).
+     
+     @param count The number of ad calls.
+     @param timeout The block returning the timeout (in seconds) of the next ad call, if any.
+     @param feedback The block called with each response and the timeout it has been drawn with.
+     @return The report of the ad calls.
+     */
+    func run(count: Int, timeout: () -> TimeInterval?, feedback: (SASAdServerSimulator.Response, TimeInterval?) -> Void) -> Report {
+        return report(from: (0..<count).map { _ in
+            let adCallTimeout = timeout()
+            let response = server.drawResponse(timeout: adCallTimeout)
+            feedback(response, adCallTimeout)
+            return response
+        })
+    }
+    
+    /**
+     Runs the given number of concurrent ad calls in real time and reports their latency.
+     
+     @param count The number of concurrent ad calls.
+     @param timeout The ad call timeout (in seconds), if any.
+     @param completion The block called on the main queue with the report once every ad call has completed.
+     */
+    func runConcurrently(count: Int, timeout: TimeInterval? = nil, completion: @escaping (Report) -> Void) {
+        let group = DispatchGroup()
+        let queue = DispatchQueue(label: "SASAdLoadGenerator")
+        var responses = [SASAdServerSimulator.Response]()
+        responses.reserveCapacity(count)
+        
+        for _ in 0..<count {
+            group.enter()
+            let start = DispatchTime.now().uptimeNanoseconds
+            server.requestAd(timeout: timeout, queue: queue) { response in
+                // The measured duration includes the scheduling overhead of the ad loading path.
+                let duration = TimeInterval(DispatchTime.now().uptimeNanoseconds - start) / 1_000_000_000.0
+                responses.append(SASAdServerSimulator.Response(outcome: response.outcome, duration: duration))
+                group.leave()
+            }
+        }
+        
+        group.notify(queue: .main) {
+            completion(report(from: responses))
+        }
+    }
+    
+    private func report(from responses: [SASAdServerSimulator.Response]) -> Report {
+        var outcomes = [SASAdServerSimulator.Outcome: Int]()
+        responses.forEach { outcomes[$0.outcome, default: 0] += 1 }
+        return Report(
+            didLoad: Percentiles(responses.filter { $0.outcome == .ad }.map(\.duration)),
+            didFailToLoad: Percentiles(responses.filter { $0.outcome != .ad }.map(\.duration)),
+            outcomes: outcomes
+        )
+    }
+    
+}
@@ -0,0 +1,86 @@
+//
+//  SASAdServerSimulatorLoader.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import UIKit
+import SASDisplayKit
+@testable import VideoHeaderAdSample
+
+/**
+ The simulator can perform the ad calls of a `SASAdLoadCoalescer`, so the coalescer and the policies it drives are
+ measured offline, on the real loading path:
+     
+     let coalescer = SASAdLoadCoalescer(loader: SASAdServerSimulator(profile: profile))
+     
+ An ad is reported as a `SASBannerView` (or `SASInterstitialManager`) which has not loaded any creative. The SDK does
+ not document its error codes, so a no-fill is reported with the `NO_FILL_ERROR_CODE` of the simulator's own
+ `ERROR_DOMAIN` (classified as `other`, like any SDK error), a timeout of the global `SASConfiguration.adCallTimeout`
+ as a URL timeout, and the simulated server errors as network errors.
+ */
+extension SASAdServerSimulator: SASAdLoader {
+    
+    // MARK: - Constants
+    
+    /// Domain of the simulated errors which are not network errors.
+    static let ERROR_DOMAIN = "SASAdServerSimulator"
+    
+    /// Code of the simulated error returned when the simulated ad server has returned no ad.
+    static let NO_FILL_ERROR_CODE = 1
+    
+    // MARK: - Loading API
+    
+    func loadBannerView(with adPlacement: SASAdPlacement, completion: @escaping BannerCompletion) -> SASAdCall {
+        return performAdCall { result in
+            completion(result.map { (bannerView: SASBannerView(frame: .zero), adInfo: $0) })
+        }
+    }
+    
+    func loadInterstitial(with adPlacement: SASAdPlacement, completion: @escaping InterstitialCompletion) -> SASAdCall {
+        return performAdCall { result in
+            completion(result.map { (interstitialManager: SASInterstitialManager(adPlacement: adPlacement), adInfo: $0) })
+        }
+    }
+    
+    // MARK: - Private methods
+    
+    private func performAdCall(completion: @escaping (Result<SASAdInfo, any Error>) -> Void) -> SASAdCall {
+        let adCall = SimulatedAdCall()
+        requestAd(timeout: SASConfiguration.shared.adCallTimeout) { response in
+            guard !adCall.isCancelled else { return }
+            completion(SASAdServerSimulator.result(of: response.outcome))
+        }
+        return adCall
+    }
+    
+    private static func result(of outcome: Outcome) -> Result<SASAdInfo, any Error> {
+        switch outcome {
+        case .ad:
+            // The ad info of a simulated ad is empty. Its initializer is unavailable in the SDK, so it is created
+            // through the Objective-C runtime: this file is only built by the test target, never by the app.
+            return .success((SASAdInfo.self as NSObject.Type).init() as! SASAdInfo)
+        case .noFill:
+            return .failure(NSError(domain: ERROR_DOMAIN, code: NO_FILL_ERROR_CODE))
+        case .timeout:
+            return .failure(NSError(domain: NSURLErrorDomain, code: NSURLErrorTimedOut))
+        case .error:
+            return .failure(NSError(domain: NSURLErrorDomain, code: NSURLErrorNetworkConnectionLost))
+        }
+    }
+    
+}
+
+/**
+ Ad call performed by the simulator, whose response is ignored once cancelled.
+ */
+private final class SimulatedAdCall: SASAdCall {
+    
+    private(set) var isCancelled = false
+    
+    func cancel() {
+        isCancelled = true
+    }
+    
+}
@@ -0,0 +1,276 @@
+//
+//  SASAdWaterfall.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import UIKit
+import SASDisplayKit
+
+/**
+ Ordered list of placements loaded one after the other until one of them returns an ad (for instance a primary
+ placement, then a house placement, then a backfill placement).
+ 
+ Each step has its own timeout and the whole waterfall has a deadline. To save the round trip of the next step when
+ the current step is slow, the ad call of the next step can be started speculatively before the current step times
+ out: its ad is only used if every previous step fails.
+ */
+struct SASAdWaterfall {
+    
+    // MARK: - Types
+    
+    /// A step of the waterfall.
+    struct Step {
+        /// The ad placement loaded by this step.
+        let adPlacement: SASAdPlacement
+        
+        /// Time (in seconds) after which the step is considered as failed.
+        var timeout: TimeInterval
+    }
+    
+    /// Errors returned by a waterfall when no step has returned an ad.
+    enum LoadingError: Error {
+        /// The waterfall does not contain any step.
+        case noStep
+        
+        /// The last step has timed out.
+        case stepTimedOut
+        
+        /// The deadline of the waterfall has been reached.
+        case deadlineExceeded
+        
+        /// The ad loaded by the last step has been claimed by another waiter of the same load before the step could
+        /// be selected.
+        case adAlreadyClaimed
+    }
+    
+    // MARK: - Constants
+    
+    /// Default ratio of the timeout of a step after which the ad call of the next step is started speculatively.
+    static let DEFAULT_SPECULATIVE_START_RATIO = 0.75
+    
+    // MARK: - Properties
+    
+    /// The steps of the waterfall, by order of preference.
+    var steps: [Step]
+    
+    /// Time (in seconds) after which the waterfall fails, whatever the state of its steps.
+    var deadline: TimeInterval
+    
+    /// Ratio of the timeout of the current step after which the ad call of the next step is started speculatively.
+    ///
+    /// Set this to 1.0 or more to only start a step once the previous one has failed.
+    var speculativeStartRatio = SASAdWaterfall.DEFAULT_SPECULATIVE_START_RATIO
+    
+    /**
+     Initialize a new waterfall.
+     
+     @param steps The steps of the waterfall, by order of preference.
+     @param deadline Time (in seconds) after which the waterfall fails.
+     */
+    init(steps: [Step], deadline: TimeInterval) {
+        self.steps = steps
+        self.deadline = deadline
+    }
+    
+}
+
+/**
+ Executor of a `SASAdWaterfall`, loading its steps through a `SASAdLoadCoalescer`.
+ 
+ @note This class must only be used from the main thread.
+ */
+final class SASAdWaterfallLoader {
+    
+    // MARK: - Types
+    
+    typealias Completion = (Result<(ad: SASCoalescedAd<SASBannerView>, stepIndex: Int), any Error>) -> Void
+    
+    private enum StepState {
+        case idle
+        case loading(SASAdLoadCoalescer.Request, timeoutWorkItem: DispatchWorkItem, startTime: TimeInterval)
+        case loaded(SASCoalescedAd<SASBannerView>)
+        case failed(any Error)
+    }
+    
+    // MARK: - Private properties
+    
+    private let waterfall: SASAdWaterfall
+    private let coalescer: SASAdLoadCoalescer
+    private var completion: Completion?
+    
+    private var states: [StepState]
+    private var deadlineWorkItem: DispatchWorkItem? = nil
+    private var speculativeStartWorkItem: DispatchWorkItem? = nil
+    private var speculativeStartIndex: Int? = nil
+    
+    // MARK: - Initialization
+    
+    /**
+     Initialize a new waterfall loader.
+     
+     @param waterfall The waterfall to load.
+     @param coalescer The coalescer used to load the steps.
+     */
+    init(waterfall: SASAdWaterfall, coalescer: SASAdLoadCoalescer = .shared) {
+        self.waterfall = waterfall
+        self.coalescer = coalescer
+        self.states = Array(repeating: .idle, count: waterfall.steps.count)
+    }
+    
+    deinit {
+        cancel()
+    }
+    
+    // MARK: - Loading API
+    
+    /**
+     Starts loading the waterfall.
+     
+     @param completion The block called with the ad of the first step returning one (already claimed) and the index
+     of this step, or the error of the last step.
+     */
+    func load(completion: @escaping Completion) {
+        guard !waterfall.steps.isEmpty else {
+            completion(.failure(SASAdWaterfall.LoadingError.noStep))
+            return
+        }
+        
+        self.completion = completion
+        
+        let deadlineWorkItem = DispatchWorkItem { [weak self] in
+            self?.finish(.failure(SASAdWaterfall.LoadingError.deadlineExceeded))
+        }
+        self.deadlineWorkItem = deadlineWorkItem
+        DispatchQueue.main.asyncAfter(deadline: .now() + waterfall.deadline, execute: deadlineWorkItem)
+        
+        advance()
+    }
+    
+    /**
+     Cancels the waterfall: its completion will not be called and every ad call in flight is cancelled.
+     */
+    func cancel() {
+        completion = nil
+        cancelPendingWork()
+    }
+    
+    // MARK: - Private methods
+    
+    /// Evaluates the state of the waterfall after each event.
+    private func advance() {
+        guard completion != nil else { return }
+        
+        // The current step is the first step which has not failed yet.
+        guard let currentIndex = states.firstIndex(where: { if case .failed = $0 { return false } else { return true } }) else {
+            if case .failed(let error) = states.last {
+                finish(.failure(error))
+            }
+            return
+        }
+        
+        if case .idle = states[currentIndex] {
+            startStep(at: currentIndex)
+        }
+        
+        switch states[currentIndex] {
+        case .loaded(let ad):
+            // The ad of a later step, already loaded speculatively, is only claimed once every previous step has
+            // failed: until then, it stays available to the other waiters of its load.
+            guard ad.claim() else {
+                states[currentIndex] = .failed(SASAdWaterfall.LoadingError.adAlreadyClaimed)
+                advance()
+                return
+            }
+            finish(.success((ad, currentIndex)))
+        case .loading(_, _, let startTime):
+            // The next step is started speculatively once the current step has used a part of its timeout.
+            let step = waterfall.steps[currentIndex]
+            scheduleSpeculativeStart(ofStepAt: currentIndex + 1, at: startTime + step.timeout * max(waterfall.speculativeStartRatio, 0.0))
+        case .idle, .failed:
+            break
+        }
+    }
+    
+    private func scheduleSpeculativeStart(ofStepAt index: Int, at time: TimeInterval) {
+        guard index < waterfall.steps.count, waterfall.speculativeStartRatio < 1.0, speculativeStartIndex != index else { return }
+        guard case .idle = states[index] else { return }
+        
+        speculativeStartWorkItem?.cancel()
+        speculativeStartIndex = index
+        let workItem = DispatchWorkItem { [weak self] in
+            guard let self, case .idle = self.states[index] else { return }
+            self.startStep(at: index)
+        }
+        speculativeStartWorkItem = workItem
+        DispatchQueue.main.asyncAfter(deadline: .now() + max(time - CACurrentMediaTime(), 0.0), execute: workItem)
+    }
+    
+    private func startStep(at index: Int) {
+        let step = waterfall.steps[index]
+        
+        let timeoutWorkItem = DispatchWorkItem { [weak self] in
+            self?.stepDidFail(at: index, error: SASAdWaterfall.LoadingError.stepTimedOut)
+        }
+        let request = coalescer.loadBannerView(with: step.adPlacement) { [weak self] result in
+            switch result {
+            case .success(let ad) where !ad.isClaimed:
+                // The ad is not claimed yet: it is claimed when the step is selected.
+                self?.stepDidLoad(at: index, ad: ad)
+            case .success:
+                // The ad has been claimed by another waiter of the same load: the step is considered as failed.
+                self?.stepDidFail(at: index, error: SASAdWaterfall.LoadingError.adAlreadyClaimed)
+            case .failure(let error):
+                self?.stepDidFail(at: index, error: error)
+            }
+        }
+        states[index] = .loading(request, timeoutWorkItem: timeoutWorkItem, startTime: CACurrentMediaTime())
+        DispatchQueue.main.asyncAfter(deadline: .now() + step.timeout, execute: timeoutWorkItem)
+    }
+    
+    private func stepDidLoad(at index: Int, ad: SASCoalescedAd<SASBannerView>) {
+        guard case .loading(_, let timeoutWorkItem, _) = states[index] else { return }
+        timeoutWorkItem.cancel()
+        states[index] = .loaded(ad)
+        advance()
+    }
+    
+    private func stepDidFail(at index: Int, error: any Error) {
+        switch states[index] {
+        case .loading(let request, let timeoutWorkItem, _):
+            request.cancel()
+            timeoutWorkItem.cancel()
+        case .idle:
+            break
+        case .loaded, .failed:
+            return
+        }
+        states[index] = .failed(error)
+        advance()
+    }
+    
+    private func finish(_ result: Result<(ad: SASCoalescedAd<SASBannerView>, stepIndex: Int), any Error>) {
+        guard let completion else { return }
+        self.completion = nil
+        cancelPendingWork()
+        completion(result)
+    }
+    
+    private func cancelPendingWork() {
+        deadlineWorkItem?.cancel()
+        deadlineWorkItem = nil
+        speculativeStartWorkItem?.cancel()
+        speculativeStartWorkItem = nil
+        
+        // The ad calls still in flight are cancelled and the ads loaded by the steps which have not won are released.
+        for state in states {
+            if case .loading(let request, let timeoutWorkItem, _) = state {
+                request.cancel()
+                timeoutWorkItem.cancel()
+            }
+        }
+        states = Array(repeating: .idle, count: states.count)
+    }
+    
+}
@@ -0,0 +1,84 @@
+//
+//  SASAllocationCounter.c
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+#include "SASAllocationCounter.h"
+
+#if defined(__linux__) && defined(__GLIBC__)
+
+#include <errno.h>
+#include <stddef.h>
+
+// The allocation functions defined below replace the ones of the C library for the whole process (the executable
+// being searched first by the dynamic linker): they count the allocation, then call the glibc implementation.
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *pointer, size_t size);
+extern void *__libc_memalign(size_t alignment, size_t size);
+
+static uint64_t allocation_count = 0;
+
+static inline void count_allocation(void) {
+    __atomic_fetch_add(&allocation_count, 1, __ATOMIC_RELAXED);
+}
+
+void *malloc(size_t size) {
+    count_allocation();
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) {
+    count_allocation();
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *pointer, size_t size) {
+    count_allocation();
+    return __libc_realloc(pointer, size);
+}
+
+void *memalign(size_t alignment, size_t size) {
+    count_allocation();
+    return __libc_memalign(alignment, size);
+}
+
+void *aligned_alloc(size_t alignment, size_t size) {
+    count_allocation();
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void **pointer, size_t alignment, size_t size) {
+    if (alignment % sizeof(void *) != 0 || (alignment & (alignment - 1)) != 0) {
+        return EINVAL;
+    }
+    count_allocation();
+    void *allocation = __libc_memalign(alignment, size);
+    if (allocation == NULL) {
+        return ENOMEM;
+    }
+    *pointer = allocation;
+    return 0;
+}
+
+bool sas_allocation_counting_supported(void) {
+    return true;
+}
+
+uint64_t sas_allocation_count(void) {
+    return __atomic_load_n(&allocation_count, __ATOMIC_RELAXED);
+}
+
+#else
+
+bool sas_allocation_counting_supported(void) {
+    return false;
+}
+
+uint64_t sas_allocation_count(void) {
+    return 0;
+}
+
+#endif
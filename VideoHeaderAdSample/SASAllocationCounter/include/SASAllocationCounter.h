@@ -0,0 +1,28 @@
+//
+//  SASAllocationCounter.h
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+#ifndef SASAllocationCounter_h
+#define SASAllocationCounter_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ Returns whether the heap allocations of the process are counted on this platform.
+ 
+ Allocations are counted by interposing the allocation functions of the C library, which is only supported with
+ glibc: on any other platform, `sas_allocation_count()` always returns 0.
+ */
+bool sas_allocation_counting_supported(void);
+
+/**
+ Returns the number of heap allocations (malloc, calloc, realloc and aligned allocations) performed by the process
+ since its start, all threads included.
+ */
+uint64_t sas_allocation_count(void);
+
+#endif /* SASAllocationCounter_h */
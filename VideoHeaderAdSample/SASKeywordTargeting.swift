@@ -0,0 +1,190 @@
+//
+//  SASKeywordTargeting.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import Foundation
+import SASDisplayKit
+
+/**
+ Structured keyword targeting, compiled into the keyword string expected by `SASAdPlacement`.
+
+ The keyword targeting of a placement is a single string made of 'key=value' pairs separated by semicolons
+ (or of bare keywords, like "header01"). Instead of concatenating the whole string each time a screen is
+ displayed, the pairs are stored here in insertion order with their encoded form: only the pairs modified
+ since the last compilation are encoded again, and the compiled string is cached until the next change.
+
+ The result of a compilation is an immutable `Compiled` value that can be reused to create any number of
+ placements.
+ */
+struct SASKeywordTargeting {
+    
+    // MARK: - Types
+    
+    /// Compiled keyword targeting, ready to be used by ad placements.
+    struct Compiled: Hashable {
+        /// The keyword targeting string.
+        let string: String
+        
+        /**
+         Returns a new ad placement using this keyword targeting.
+         
+         @param siteId The site id that should be used when loading an ad.
+         @param pageId The page id that should be used when loading an ad.
+         @param formatId The format id that should be used when loading an ad.
+         @return An initialized instance of SASAdPlacement.
+         */
+        func adPlacement(siteId: Int, pageId: Int, formatId: Int) -> SASAdPlacement {
+            return SASAdPlacement(siteId: siteId, pageId: pageId, formatId: formatId, keywordTargeting: string.isEmpty ? nil : string)
+        }
+    }
+    
+    /// Counters describing the work done by the compilations.
+    struct Counters: Equatable {
+        /// Number of compilations requested.
+        var compilations = 0
+        
+        /// Number of compilations served from the cache.
+        var cachedCompilations = 0
+        
+        /// Number of pairs encoded.
+        var encodedPairs = 0
+    }
+    
+    private struct Pair {
+        var value: String?
+        var encoded: String? = nil
+    }
+    
+    // MARK: - Properties
+    
+    private var keys = [String]()
+    private var pairs = [String: Pair]()
+    private var compiledCache: Compiled? = nil
+    
+    /// Counters of the compilations performed on this targeting.
+    private(set) var counters = Counters()
+    
+    // MARK: - Initialization
+    
+    init() {}
+    
+    /**
+     Initialize a new keyword targeting from a list of pairs.
+     
+     @param pairs The 'key=value' pairs, in the order they must be compiled. A nil value denotes a bare keyword.
+     */
+    init(_ pairs: KeyValuePairs<String, String?>) {
+        for (key, value) in pairs {
+            setValue(value, forKey: key)
+        }
+    }
+    
+    // MARK: - Edition
+    
+    /// The keys of the targeting, in insertion order.
+    var allKeys: [String] {
+        return keys
+    }
+    
+    /**
+     Sets the value of a key, only invalidating its encoded form if the value has changed.
+     
+     @param value The value of the key, or nil for a bare keyword.
+     @param key The key.
+     */
+    mutating func setValue(_ value: String?, forKey key: String) {
+        if let pair = pairs[key] {
+            guard pair.value != value else { return }
+        } else {
+            keys.append(key)
+        }
+        pairs[key] = Pair(value: value)
+        compiledCache = nil
+    }
+    
+    /**
+     Adds a bare keyword (without any value).
+     
+     @param keyword The keyword.
+     */
+    mutating func addKeyword(_ keyword: String) {
+        setValue(nil, forKey: keyword)
+    }
+    
+    /**
+     Removes a key from the targeting.
+     
+     @param key The key to remove.
+     */
+    mutating func removeValue(forKey key: String) {
+        guard pairs.removeValue(forKey: key) != nil else { return }
+        keys.removeAll { $0 == key }
+        compiledCache = nil
+    }
+    
+    /// Returns the value of a key, or nil if the key is not set or is a bare keyword.
+    func value(forKey key: String) -> String? {
+        return pairs[key]?.value
+    }
+    
+    // MARK: - Compilation
+    
+    /**
+     Compiles the targeting into a keyword string.
+     
+     Only the pairs modified since the last compilation are encoded again, and the previous result is returned
+     directly if nothing has changed.
+     
+     @return The compiled targeting.
+     */
+    mutating func compile() -> Compiled {
+        counters.compilations += 1
+        
+        if let compiledCache {
+            counters.cachedCompilations += 1
+            return compiledCache
+        }
+        
+        var string = ""
+        for key in keys {
+            guard var pair = pairs[key] else { continue }
+            let encoded: String
+            if let cached = pair.encoded {
+                encoded = cached
+            } else {
+                encoded = SASKeywordTargeting.encode(key: key, value: pair.value)
+                pair.encoded = encoded
+                pairs[key] = pair
+                counters.encodedPairs += 1
+            }
+            
+            if !string.isEmpty {
+                string.append(";")
+            }
+            string.append(encoded)
+        }
+        
+        let compiled = Compiled(string: string)
+        compiledCache = compiled
+        return compiled
+    }
+    
+    // MARK: - Encoding
+    
+    /// Characters that must be escaped in keys and values since they are used as separators.
+    private static let allowedCharacters = CharacterSet(charactersIn: ";=%").inverted
+    
+    private static func encode(key: String, value: String?) -> String {
+        let encodedKey = escape(key)
+        guard let value else { return encodedKey }
+        return encodedKey + "=" + escape(value)
+    }
+    
+    private static func escape(_ string: String) -> String {
+        return string.addingPercentEncoding(withAllowedCharacters: allowedCharacters) ?? string
+    }
+    
+}
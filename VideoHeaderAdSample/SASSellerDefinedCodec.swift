@@ -0,0 +1,293 @@
+//
+//  SASSellerDefinedCodec.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import Foundation
+import SASDisplayKit
+
+/**
+ Compact binary codec for seller-defined audiences and contents.
+
+ This codec is an alternative to `NSKeyedArchiver` to persist large lists of `SASSellerDefinedAudience` and
+ `SASSellerDefinedContent` between launches. The format is versioned and stores every distinct string only
+ once, in a shared string table:
+
+     magic "SASD" | version (1 byte)
+     string count (varint) | for each string: length (varint) + UTF-8 bytes
+     audience count (varint) | audiences
+     content count (varint) | contents
+
+ An audience or a content is encoded as 'ID ref, name ref, segment count', followed by its segments, each of
+ them encoded as 'ID ref, name ref, value ref'. A string ref is the index of the string in the table plus one
+ ('0' for nil), and a segment count is the number of segments plus one ('0' for nil segments).
+
+ Archives can be decoded directly from a memory-mapped file: the bytes are parsed in place and each string
+ of the table is materialized only once, whatever the number of segments referencing it.
+ */
+enum SASSellerDefinedCodec {
+    
+    // MARK: - Constants
+    
+    /// Current version of the binary format.
+    static let VERSION: UInt8 = 1
+    
+    private static let MAGIC: [UInt8] = Array("SASD".utf8)
+    
+    // MARK: - Types
+    
+    /// Errors thrown when decoding an invalid archive.
+    enum DecodingError: Error {
+        /// The archive does not start with the expected magic bytes.
+        case invalidHeader
+        
+        /// The archive has been written with an unsupported version of the format.
+        case unsupportedVersion(UInt8)
+        
+        /// The archive ends before the end of the encoded values.
+        case truncated
+        
+        /// A value references a string that is not in the string table.
+        case invalidStringReference
+    }
+    
+    /// The content of an archive.
+    struct Archive {
+        var audiences: [SASSellerDefinedAudience]
+        var contents: [SASSellerDefinedContent]
+    }
+    
+    // MARK: - Encoding
+    
+    /**
+     Encodes seller-defined audiences and contents.
+     
+     @param archive The audiences and contents to encode.
+     @return The encoded bytes.
+     */
+    static func encode(_ archive: Archive) -> Data {
+        // The string table is built first so every value can be encoded as a reference.
+        var stringTable = StringTable()
+        for audience in archive.audiences {
+            stringTable.register(audience.id, audience.name, audience.segments)
+        }
+        for content in archive.contents {
+            stringTable.register(content.id, content.name, content.segments)
+        }
+        
+        var writer = Writer()
+        writer.bytes.append(contentsOf: MAGIC)
+        writer.bytes.append(VERSION)
+        
+        writer.writeVarint(stringTable.strings.count)
+        for string in stringTable.strings {
+            let utf8 = string.utf8
+            writer.writeVarint(utf8.count)
+            writer.bytes.append(contentsOf: utf8)
+        }
+        
+        writer.writeVarint(archive.audiences.count)
+        for audience in archive.audiences {
+            writer.writeEntry(audience.id, audience.name, audience.segments, stringTable: stringTable)
+        }
+        writer.writeVarint(archive.contents.count)
+        for content in archive.contents {
+            writer.writeEntry(content.id, content.name, content.segments, stringTable: stringTable)
+        }
+        
+        return Data(writer.bytes)
+    }
+    
+    // MARK: - Decoding
+    
+    /**
+     Decodes seller-defined audiences and contents.
+     
+     @param data The encoded bytes.
+     @return The decoded audiences and contents.
+     */
+    static func decode(_ data: Data) throws -> Archive {
+        return try data.withUnsafeBytes { buffer in
+            var reader = Reader(buffer: buffer)
+            
+            guard reader.remaining >= MAGIC.count + 1, MAGIC.allSatisfy({ $0 == reader.readByteUnchecked() }) else {
+                throw DecodingError.invalidHeader
+            }
+            let version = reader.readByteUnchecked()
+            guard version == VERSION else {
+                throw DecodingError.unsupportedVersion(version)
+            }
+            
+            // Each string of the table is materialized once, directly from the archive bytes.
+            let stringCount = try reader.readVarint()
+            var strings = [String]()
+            strings.reserveCapacity(min(stringCount, reader.remaining))
+            for _ in 0..<stringCount {
+                strings.append(try reader.readString())
+            }
+            
+            let audienceCount = try reader.readVarint()
+            var audiences = [SASSellerDefinedAudience]()
+            audiences.reserveCapacity(min(audienceCount, reader.remaining))
+            for _ in 0..<audienceCount {
+                let (id, name, segments) = try reader.readEntry(strings: strings)
+                audiences.append(SASSellerDefinedAudience(id: id, name: name, segments: segments))
+            }
+            
+            let contentCount = try reader.readVarint()
+            var contents = [SASSellerDefinedContent]()
+            contents.reserveCapacity(min(contentCount, reader.remaining))
+            for _ in 0..<contentCount {
+                let (id, name, segments) = try reader.readEntry(strings: strings)
+                contents.append(SASSellerDefinedContent(id: id, name: name, segments: segments))
+            }
+            
+            return Archive(audiences: audiences, contents: contents)
+        }
+    }
+    
+    /**
+     Decodes seller-defined audiences and contents from a file, which is memory-mapped instead of being read.
+     
+     @param url The URL of the archive file.
+     @return The decoded audiences and contents.
+     */
+    static func decode(contentsOf url: URL) throws -> Archive {
+        return try decode(Data(contentsOf: url, options: .alwaysMapped))
+    }
+    
+}
+
+// MARK: - String table
+
+private struct StringTable {
+    
+    private(set) var strings = [String]()
+    private var indexes = [String: Int]()
+    
+    mutating func register(_ id: String?, _ name: String?, _ segments: [SASSellerDefinedSegment]?) {
+        register(id)
+        register(name)
+        segments?.forEach {
+            register($0.id)
+            register($0.name)
+            register($0.value)
+        }
+    }
+    
+    private mutating func register(_ string: String?) {
+        guard let string, indexes[string] == nil else { return }
+        indexes[string] = strings.count
+        strings.append(string)
+    }
+    
+    func reference(_ string: String?) -> Int {
+        guard let string, let index = indexes[string] else { return 0 }
+        return index + 1
+    }
+    
+}
+
+// MARK: - Writer
+
+private struct Writer {
+    
+    var bytes = [UInt8]()
+    
+    mutating func writeVarint(_ value: Int) {
+        var value = UInt64(value)
+        while value >= 0x80 {
+            bytes.append(UInt8(value & 0x7f) | 0x80)
+            value >>= 7
+        }
+        bytes.append(UInt8(value))
+    }
+    
+    mutating func writeEntry(_ id: String?, _ name: String?, _ segments: [SASSellerDefinedSegment]?, stringTable: StringTable) {
+        writeVarint(stringTable.reference(id))
+        writeVarint(stringTable.reference(name))
+        guard let segments else {
+            writeVarint(0)
+            return
+        }
+        writeVarint(segments.count + 1)
+        for segment in segments {
+            writeVarint(stringTable.reference(segment.id))
+            writeVarint(stringTable.reference(segment.name))
+            writeVarint(stringTable.reference(segment.value))
+        }
+    }
+    
+}
+
+// MARK: - Reader
+
+private struct Reader {
+    
+    let buffer: UnsafeRawBufferPointer
+    private var position = 0
+    
+    init(buffer: UnsafeRawBufferPointer) {
+        self.buffer = buffer
+    }
+    
+    var remaining: Int {
+        return buffer.count - position
+    }
+    
+    mutating func readByteUnchecked() -> UInt8 {
+        defer { position += 1 }
+        return buffer[position]
+    }
+    
+    mutating func readVarint() throws -> Int {
+        var value: UInt64 = 0
+        var shift: UInt64 = 0
+        while true {
+            guard position < buffer.count, shift < 63 else { throw SASSellerDefinedCodec.DecodingError.truncated }
+            let byte = readByteUnchecked()
+            value |= UInt64(byte & 0x7f) << shift
+            if byte & 0x80 == 0 {
+                break
+            }
+            shift += 7
+        }
+        guard value <= UInt64(Int.max) else { throw SASSellerDefinedCodec.DecodingError.truncated }
+        return Int(value)
+    }
+    
+    mutating func readString() throws -> String {
+        let length = try readVarint()
+        guard length <= remaining else { throw SASSellerDefinedCodec.DecodingError.truncated }
+        defer { position += length }
+        return String(decoding: UnsafeRawBufferPointer(rebasing: buffer[position..<(position + length)]), as: UTF8.self)
+    }
+    
+    mutating func readStringReference(strings: [String]) throws -> String? {
+        let reference = try readVarint()
+        guard reference > 0 else { return nil }
+        guard reference <= strings.count else { throw SASSellerDefinedCodec.DecodingError.invalidStringReference }
+        return strings[reference - 1]
+    }
+    
+    mutating func readEntry(strings: [String]) throws -> (String?, String?, [SASSellerDefinedSegment]?) {
+        let id = try readStringReference(strings: strings)
+        let name = try readStringReference(strings: strings)
+        let segmentCount = try readVarint()
+        guard segmentCount > 0 else { return (id, name, nil) }
+        
+        var segments = [SASSellerDefinedSegment]()
+        segments.reserveCapacity(min(segmentCount - 1, remaining))
+        for _ in 1..<segmentCount {
+            segments.append(SASSellerDefinedSegment(
+                id: try readStringReference(strings: strings),
+                name: try readStringReference(strings: strings),
+                value: try readStringReference(strings: strings)
+            ))
+        }
+        return (id, name, segments)
+    }
+    
+}
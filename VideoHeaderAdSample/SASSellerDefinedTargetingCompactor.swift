@@ -0,0 +1,210 @@
+//
+//  SASSellerDefinedTargetingCompactor.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import Foundation
+import SASDisplayKit
+
+/**
+ Request-building stage compacting the seller-defined audiences and contents of a placement.
+
+ Large audience lists often repeat the same segments across entries (or the same entry several times), and all
+ of them are sent verbatim on every ad call. This optional stage, applied on a `SASAdPlacement` before loading
+ an ad, merges the entries sharing the same ID and name, removes duplicated segments and, if a payload size
+ budget is set, drops the trailing segments until the estimated payload fits in it.
+
+ Each compaction returns a report with the estimated bytes saved and the build time, so the gain can be
+ measured per ad call.
+ */
+struct SASSellerDefinedTargetingCompactor {
+    
+    // MARK: - Types
+    
+    /// Report of a compaction.
+    struct Report: Equatable {
+        /// Estimated payload size (in bytes) of the audiences and contents before compaction.
+        var originalSize = 0
+        
+        /// Estimated payload size (in bytes) of the audiences and contents after compaction.
+        var compactedSize = 0
+        
+        /// Number of entries merged into another entry with the same ID and name.
+        var mergedEntries = 0
+        
+        /// Number of duplicated segments removed.
+        var removedDuplicateSegments = 0
+        
+        /// Number of segments dropped to fit in the payload size budget.
+        var droppedSegments = 0
+        
+        /// Duration (in seconds) of the compaction.
+        var buildDuration: TimeInterval = 0.0
+        
+        /// Estimated number of bytes saved by the compaction.
+        var bytesSaved: Int {
+            return originalSize - compactedSize
+        }
+    }
+    
+    // MARK: - Properties
+    
+    /// Maximum estimated payload size (in bytes) of the audiences and contents, or nil for no limit.
+    ///
+    /// When the payload is too large, the segments are dropped starting from the end of the last entry, contents
+    /// first, so the first segments (usually the most relevant ones) are kept.
+    var maximumPayloadSize: Int? = nil
+    
+    // MARK: - Compaction
+    
+    /**
+     Compacts the seller-defined audiences and contents of a placement, in place.
+     
+     @param adPlacement The ad placement to compact, before using it to load an ad.
+     @return The report of the compaction.
+     */
+    @discardableResult
+    func apply(to adPlacement: SASAdPlacement) -> Report {
+        let startTime = DispatchTime.now().uptimeNanoseconds
+        var report = Report()
+        
+        var audiences = (adPlacement.sellerDefinedAudiences ?? []).map { Entry(id: $0.id, name: $0.name, segments: $0.segments) }
+        var contents = (adPlacement.sellerDefinedContents ?? []).map { Entry(id: $0.id, name: $0.name, segments: $0.segments) }
+        report.originalSize = Entry.payloadSize(audiences) + Entry.payloadSize(contents)
+        
+        audiences = deduplicate(audiences, report: &report)
+        contents = deduplicate(contents, report: &report)
+        
+        if let maximumPayloadSize {
+            var size = Entry.payloadSize(audiences) + Entry.payloadSize(contents)
+            dropSegments(of: &contents, size: &size, maximumSize: maximumPayloadSize, report: &report)
+            dropSegments(of: &audiences, size: &size, maximumSize: maximumPayloadSize, report: &report)
+        }
+        report.compactedSize = Entry.payloadSize(audiences) + Entry.payloadSize(contents)
+        
+        // The placement is only modified if the compaction has changed something.
+        if report.mergedEntries > 0 || report.removedDuplicateSegments > 0 || report.droppedSegments > 0 {
+            if adPlacement.sellerDefinedAudiences != nil {
+                adPlacement.sellerDefinedAudiences = audiences.map {
+                    SASSellerDefinedAudience(id: $0.id, name: $0.name, segments: $0.sdkSegments)
+                }
+            }
+            if adPlacement.sellerDefinedContents != nil {
+                adPlacement.sellerDefinedContents = contents.map {
+                    SASSellerDefinedContent(id: $0.id, name: $0.name, segments: $0.sdkSegments)
+                }
+            }
+        }
+        
+        report.buildDuration = TimeInterval(DispatchTime.now().uptimeNanoseconds - startTime) / 1_000_000_000.0
+        return report
+    }
+    
+    // MARK: - Internal logic
+    
+    private func deduplicate(_ entries: [Entry], report: inout Report) -> [Entry] {
+        var result = [Entry]()
+        var indexes = [EntryIdentifier: Int]()
+        var seenSegments = [Set<Segment>]()
+        
+        for entry in entries {
+            let identifier = EntryIdentifier(id: entry.id, name: entry.name)
+            let index: Int
+            if let existingIndex = indexes[identifier] {
+                // Entries with the same ID and name are merged into the first one.
+                index = existingIndex
+                report.mergedEntries += 1
+            } else {
+                index = result.count
+                indexes[identifier] = index
+                result.append(Entry(id: entry.id, name: entry.name, segments: entry.segments == nil ? nil : [Segment]()))
+                seenSegments.append([])
+            }
+            
+            for segment in entry.segments ?? [] {
+                if seenSegments[index].insert(segment).inserted {
+                    result[index].segments = result[index].segments ?? []
+                    result[index].segments?.append(segment)
+                } else {
+                    report.removedDuplicateSegments += 1
+                }
+            }
+        }
+        return result
+    }
+    
+    private func dropSegments(of entries: inout [Entry], size: inout Int, maximumSize: Int, report: inout Report) {
+        var entryIndex = entries.count - 1
+        while size > maximumSize && entryIndex >= 0 {
+            if let segment = entries[entryIndex].segments?.last {
+                entries[entryIndex].segments?.removeLast()
+                size -= segment.payloadSize + (entries[entryIndex].segments?.isEmpty == false ? 1 : 0)
+                report.droppedSegments += 1
+            } else {
+                entryIndex -= 1
+            }
+        }
+    }
+    
+}
+
+// MARK: - Values
+
+private struct EntryIdentifier: Hashable {
+    let id: String?
+    let name: String?
+}
+
+private struct Segment: Hashable {
+    let id: String?
+    let name: String?
+    let value: String?
+    
+    /// Estimated size of the segment once serialized as an OpenRTB segment object.
+    var payloadSize: Int {
+        // {"id":"…","name":"…","value":"…"}
+        return 2 + Segment.fieldSize("id", id) + Segment.fieldSize("name", name) + Segment.fieldSize("value", value)
+    }
+    
+    static func fieldSize(_ key: String, _ value: String?) -> Int {
+        guard let value else { return 0 }
+        // "key":"value",
+        return key.utf8.count + value.utf8.count + 6
+    }
+}
+
+private struct Entry {
+    let id: String?
+    let name: String?
+    var segments: [Segment]?
+    
+    init(id: String?, name: String?, segments: [Segment]?) {
+        self.id = id
+        self.name = name
+        self.segments = segments
+    }
+    
+    init(id: String?, name: String?, segments: [SASSellerDefinedSegment]?) {
+        self.init(id: id, name: name, segments: segments?.map { Segment(id: $0.id, name: $0.name, value: $0.value) })
+    }
+    
+    var sdkSegments: [SASSellerDefinedSegment]? {
+        return segments?.map { SASSellerDefinedSegment(id: $0.id, name: $0.name, value: $0.value) }
+    }
+    
+    /// Estimated size of the entry once serialized as an OpenRTB data object.
+    var payloadSize: Int {
+        // {"id":"…","name":"…","segment":[…]}
+        var size = 2 + Segment.fieldSize("id", id) + Segment.fieldSize("name", name)
+        if let segments {
+            size += 12 + segments.reduce(0) { $0 + $1.payloadSize } + max(segments.count - 1, 0)
+        }
+        return size
+    }
+    
+    static func payloadSize(_ entries: [Entry]) -> Int {
+        return 2 + entries.reduce(0) { $0 + $1.payloadSize } + max(entries.count - 1, 0)
+    }
+}
@@ -0,0 +1,350 @@
+//
+//  SASSupplyChain.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import Foundation
+import SASDisplayKit
+
+/**
+ Typed representation of an IAB SupplyChain object.
+ 
+ The `supplyChainObjectString` of a `SASAdPlacement` must use the IAB non-OpenRTB string form:
+     
+     ver,complete!asi,sid,hp,rid,name,domain,ext!asi,sid,hp,rid,name,domain,ext…
+     
+ where every field value is URL-encoded. This type builds this string from typed nodes (serializing into a
+ reusable buffer), parses an existing string, and validates a string in a single pass without allocating.
+ */
+struct SASSupplyChain: Equatable {
+    
+    // MARK: - Types
+    
+    /// A node of the supply chain, aka an entity participating in the sale of the inventory.
+    struct Node: Equatable {
+        /// The canonical domain name of the advertising system (SSP, exchange, …).
+        var asi: String
+        
+        /// The identifier of the seller in the advertising system.
+        var sid: String
+        
+        /// Whether the node is involved in the flow of payment for the inventory.
+        var hp = true
+        
+        /// The request ID issued by this node, if any.
+        var rid: String? = nil
+        
+        /// The name of the company paid for the inventory, if any.
+        var name: String? = nil
+        
+        /// The business domain name of this node, if any.
+        var domain: String? = nil
+        
+        /// Extension data, if any.
+        var ext: String? = nil
+    }
+    
+    /// Errors returned when validating or parsing a supply chain string.
+    enum ValidationError: Error, Equatable {
+        /// The string does not start with a supported version followed by the 'complete' flag.
+        case invalidHeader
+        
+        /// The 'complete' flag is neither '0' nor '1'.
+        case invalidCompleteFlag
+        
+        /// A node has too many fields.
+        case tooManyFields(node: Int)
+        
+        /// A node lacks its mandatory 'asi', 'sid' or 'hp' field.
+        case missingField(node: Int)
+        
+        /// The 'hp' field of a node is neither '0' nor '1'.
+        case invalidHpFlag(node: Int)
+        
+        /// A field contains an invalid percent-encoded sequence, or does not decode to valid UTF-8.
+        case invalidEncoding(node: Int)
+        
+        /// The chain does not contain any node.
+        case emptyChain
+    }
+    
+    // MARK: - Constants
+    
+    /// Version of the SupplyChain specification implemented by this type.
+    static let VERSION = "1.0"
+    
+    private static let FIELD_COUNT = 7
+    private static let HEX_DIGITS = Array("0123456789ABCDEF".utf8)
+    
+    // MARK: - Properties
+    
+    /// Whether the chain contains all the nodes involved in the transaction, back to the owner of the site.
+    var isComplete: Bool
+    
+    /// The nodes of the chain, in the order of the transaction.
+    var nodes: [Node]
+    
+    // MARK: - Initialization
+    
+    init(isComplete: Bool, nodes: [Node]) {
+        self.isComplete = isComplete
+        self.nodes = nodes
+    }
+    
+    /**
+     Parses a supply chain string.
+     
+     @param string The supply chain string, using the IAB non-OpenRTB string form.
+     */
+    init(string: String) throws {
+        if let error = SASSupplyChain.validate(string) {
+            throw error
+        }
+        
+        // The string is valid: it can be split without further checks, every field decoding to valid UTF-8.
+        let parts = string.split(separator: "!", omittingEmptySubsequences: false)
+        isComplete = parts[0].hasSuffix("1")
+        nodes = parts.dropFirst().map { part in
+            let fields = part.split(separator: ",", omittingEmptySubsequences: false).map {
+                $0.isEmpty ? nil : SASSupplyChain.decodeField($0)
+            }
+            func field(_ index: Int) -> String? {
+                return index < fields.count ? fields[index] : nil
+            }
+            return Node(asi: field(0) ?? "", sid: field(1) ?? "", hp: field(2) == "1", rid: field(3), name: field(4), domain: field(5), ext: field(6))
+        }
+    }
+    
+    // MARK: - Serialization
+    
+    /**
+     Serializes the supply chain into the given buffer.
+     
+     The buffer is cleared first but keeps its capacity, so it can be reused across requests without allocating.
+     
+     @param buffer The buffer receiving the UTF-8 bytes of the supply chain string.
+     */
+    func serialize(into buffer: inout [UInt8]) {
+        buffer.removeAll(keepingCapacity: true)
+        buffer.append(contentsOf: SASSupplyChain.VERSION.utf8)
+        buffer.append(UInt8(ascii: ","))
+        buffer.append(UInt8(ascii: isComplete ? "1" : "0"))
+        
+        for node in nodes {
+            buffer.append(UInt8(ascii: "!"))
+            SASSupplyChain.appendEncoded(node.asi, to: &buffer)
+            buffer.append(UInt8(ascii: ","))
+            SASSupplyChain.appendEncoded(node.sid, to: &buffer)
+            buffer.append(UInt8(ascii: ","))
+            buffer.append(UInt8(ascii: node.hp ? "1" : "0"))
+            
+            // Trailing empty optional fields are omitted.
+            let optionalFieldCount = node.ext != nil ? 4 : node.domain != nil ? 3 : node.name != nil ? 2 : node.rid != nil ? 1 : 0
+            if optionalFieldCount >= 1 { SASSupplyChain.appendOptionalField(node.rid, to: &buffer) }
+            if optionalFieldCount >= 2 { SASSupplyChain.appendOptionalField(node.name, to: &buffer) }
+            if optionalFieldCount >= 3 { SASSupplyChain.appendOptionalField(node.domain, to: &buffer) }
+            if optionalFieldCount >= 4 { SASSupplyChain.appendOptionalField(node.ext, to: &buffer) }
+        }
+    }
+    
+    /// The supply chain string, using the IAB non-OpenRTB string form.
+    var stringValue: String {
+        var buffer = [UInt8]()
+        serialize(into: &buffer)
+        return String(decoding: buffer, as: UTF8.self)
+    }
+    
+    /**
+     Sets the supply chain string of an ad placement.
+     
+     @param adPlacement The ad placement using this supply chain.
+     */
+    func apply(to adPlacement: SASAdPlacement) {
+        adPlacement.supplyChainObjectString = stringValue
+    }
+    
+    private static func appendOptionalField(_ value: String?, to buffer: inout [UInt8]) {
+        buffer.append(UInt8(ascii: ","))
+        if let value {
+            appendEncoded(value, to: &buffer)
+        }
+    }
+    
+    private static func appendEncoded(_ value: String, to buffer: inout [UInt8]) {
+        for byte in value.utf8 {
+            if isUnreserved(byte) {
+                buffer.append(byte)
+            } else {
+                buffer.append(UInt8(ascii: "%"))
+                buffer.append(HEX_DIGITS[Int(byte >> 4)])
+                buffer.append(HEX_DIGITS[Int(byte & 0x0f)])
+            }
+        }
+    }
+    
+    private static func isUnreserved(_ byte: UInt8) -> Bool {
+        switch byte {
+        case UInt8(ascii: "a")...UInt8(ascii: "z"), UInt8(ascii: "A")...UInt8(ascii: "Z"), UInt8(ascii: "0")...UInt8(ascii: "9"):
+            return true
+        case UInt8(ascii: "-"), UInt8(ascii: "."), UInt8(ascii: "_"), UInt8(ascii: "~"):
+            return true
+        default:
+            return false
+        }
+    }
+    
+    // MARK: - Validation
+    
+    /**
+     Validates a supply chain string in a single pass, without allocating.
+     
+     @param string The supply chain string to validate.
+     @return The first error found in the string, or nil if the string is valid.
+     */
+    static func validate(_ string: String) -> ValidationError? {
+        var utf8 = string.utf8.makeIterator()
+        
+        // Header: the version followed by the 'complete' flag.
+        for expected in VERSION.utf8 {
+            guard utf8.next() == expected else { return .invalidHeader }
+        }
+        guard utf8.next() == UInt8(ascii: ",") else { return .invalidHeader }
+        guard let complete = utf8.next(), complete == UInt8(ascii: "0") || complete == UInt8(ascii: "1") else {
+            return .invalidCompleteFlag
+        }
+        guard let separator = utf8.next() else { return .emptyChain }
+        guard separator == UInt8(ascii: "!") else { return .invalidCompleteFlag }
+        
+        // Nodes: fields are validated as they are read, the state being reset on each node separator.
+        var node = 0
+        var field = 0
+        var fieldLength = 0
+        var hpValue: UInt8 = 0
+        var pendingHexDigits = 0
+        var escapedByte: UInt8 = 0
+        
+        // The decoded bytes of a field (unreserved bytes and percent-encoded ones alike) must form valid UTF-8,
+        // otherwise the field cannot be decoded: the UTF-8 sequence being decoded is tracked byte by byte.
+        var pendingContinuationBytes = 0
+        var continuationRange: ClosedRange<UInt8> = 0x80...0xBF
+        
+        func decode(_ byte: UInt8) -> Bool {
+            if pendingContinuationBytes > 0 {
+                guard continuationRange.contains(byte) else { return false }
+                pendingContinuationBytes -= 1
+                continuationRange = 0x80...0xBF
+                return true
+            }
+            
+            // Lead byte: overlong encodings, surrogates and code points above U+10FFFF are rejected.
+            switch byte {
+            case 0x00...0x7F:
+                return true
+            case 0xC2...0xDF:
+                pendingContinuationBytes = 1
+            case 0xE0:
+                pendingContinuationBytes = 2
+                continuationRange = 0xA0...0xBF
+            case 0xED:
+                pendingContinuationBytes = 2
+                continuationRange = 0x80...0x9F
+            case 0xE1...0xEF:
+                pendingContinuationBytes = 2
+            case 0xF0:
+                pendingContinuationBytes = 3
+                continuationRange = 0x90...0xBF
+            case 0xF1...0xF3:
+                pendingContinuationBytes = 3
+            case 0xF4:
+                pendingContinuationBytes = 3
+                continuationRange = 0x80...0x8F
+            default:
+                return false
+            }
+            return true
+        }
+        
+        func endField() -> ValidationError? {
+            guard pendingHexDigits == 0, pendingContinuationBytes == 0 else { return .invalidEncoding(node: node) }
+            if field < 2 && fieldLength == 0 {
+                return .missingField(node: node)
+            }
+            if field == 2 {
+                guard fieldLength == 1, hpValue == UInt8(ascii: "0") || hpValue == UInt8(ascii: "1") else {
+                    return fieldLength == 0 ? .missingField(node: node) : .invalidHpFlag(node: node)
+                }
+            }
+            return nil
+        }
+        
+        while let byte = utf8.next() {
+            switch byte {
+            case UInt8(ascii: ","):
+                if let error = endField() { return error }
+                field += 1
+                fieldLength = 0
+                guard field < FIELD_COUNT else { return .tooManyFields(node: node) }
+            case UInt8(ascii: "!"):
+                if let error = endField() { return error }
+                guard field >= 2 else { return .missingField(node: node) }
+                node += 1
+                field = 0
+                fieldLength = 0
+            default:
+                if pendingHexDigits > 0 {
+                    guard let digit = hexDigitValue(of: byte) else { return .invalidEncoding(node: node) }
+                    escapedByte = escapedByte << 4 | digit
+                    pendingHexDigits -= 1
+                    if pendingHexDigits == 0 {
+                        guard decode(escapedByte) else { return .invalidEncoding(node: node) }
+                    }
+                } else if byte == UInt8(ascii: "%") {
+                    pendingHexDigits = 2
+                    escapedByte = 0
+                } else {
+                    guard decode(byte) else { return .invalidEncoding(node: node) }
+                }
+                if field == 2 {
+                    hpValue = byte
+                }
+                fieldLength += 1
+            }
+        }
+        
+        if let error = endField() { return error }
+        guard field >= 2 else { return .missingField(node: node) }
+        return nil
+    }
+    
+    private static func hexDigitValue(of byte: UInt8) -> UInt8? {
+        switch byte {
+        case UInt8(ascii: "0")...UInt8(ascii: "9"):
+            return byte - UInt8(ascii: "0")
+        case UInt8(ascii: "a")...UInt8(ascii: "f"):
+            return byte - UInt8(ascii: "a") + 10
+        case UInt8(ascii: "A")...UInt8(ascii: "F"):
+            return byte - UInt8(ascii: "A") + 10
+        default:
+            return nil
+        }
+    }
+    
+    /// Decodes the percent-encoded sequences of a field of a validated string, whose sequences and decoded UTF-8 are
+    /// therefore known to be valid.
+    private static func decodeField(_ field: Substring) -> String {
+        var bytes = [UInt8]()
+        bytes.reserveCapacity(field.utf8.count)
+        var utf8 = field.utf8.makeIterator()
+        while let byte = utf8.next() {
+            if byte == UInt8(ascii: "%"), let high = utf8.next().flatMap(hexDigitValue(of:)), let low = utf8.next().flatMap(hexDigitValue(of:)) {
+                bytes.append(high << 4 | low)
+            } else {
+                bytes.append(byte)
+            }
+        }
+        return String(decoding: bytes, as: UTF8.self)
+    }
+    
+}
@@ -0,0 +1,64 @@
+//
+//  SASTokenBucket.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import Foundation
+
+/**
+ Token bucket capping the rate of the extra ad calls (hedges, retries) relative to the regular ones.
+ 
+ Each regular ad call earns `ratio` token, up to `maximumBurst` tokens; each extra ad call spends one. With a ratio
+ of 0.1, at most 10% extra ad calls are performed in the long run, while up to `maximumBurst` of them can be
+ performed in a row once the budget has been saved up. The bucket starts full.
+ */
+struct SASTokenBucket: Equatable {
+    
+    // MARK: - Properties
+    
+    /// Number of tokens earned by each regular ad call.
+    let ratio: Double
+    
+    /// Highest number of tokens the bucket can hold.
+    let maximumBurst: Double
+    
+    /// Number of tokens currently available.
+    private(set) var tokens: Double
+    
+    // MARK: - Initialization
+    
+    /**
+     Initialize a new full token bucket.
+     
+     @param ratio The number of tokens earned by each regular ad call.
+     @param maximumBurst The highest number of tokens the bucket can hold.
+     */
+    init(ratio: Double, maximumBurst: Double) {
+        self.ratio = ratio
+        self.maximumBurst = maximumBurst
+        self.tokens = maximumBurst
+    }
+    
+    // MARK: - Public API
+    
+    /**
+     Must be called when a regular ad call starts, so it earns its share of tokens.
+     */
+    mutating func adCallDidStart() {
+        tokens = min(tokens + ratio, maximumBurst)
+    }
+    
+    /**
+     Spends a token for an extra ad call.
+     
+     @return true if a token has been spent, false if the bucket is empty (the extra ad call must not be performed).
+     */
+    mutating func spend() -> Bool {
+        guard tokens >= 1.0 else { return false }
+        tokens -= 1.0
+        return true
+    }
+    
+}
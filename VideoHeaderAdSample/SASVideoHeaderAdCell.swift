@@ -20,7 +20,8 @@ protocol SASVideoHeaderAdCellDelegate: NSObject {
     /**
      Called when the video header ad cell fails to load an ad.
      
-     @note The ad cell will automatically collapse in this case.
+     @note The failed load is first retried according to the retry policy of the ad cell: this method is only called
+     once the ad cell gives up, and the ad cell will automatically collapse in this case.
      */
     func videoHeaderAdCell(_ videoHeaderAdCell: SASVideoHeaderAdCell, didFailToLoad error: any Error)
     
@@ -37,6 +38,36 @@ protocol SASVideoHeaderAdCellDelegate: NSObject {
 
 class SASVideoHeaderAdCell: UITableViewCell, SASBannerViewDelegate {
     
+    // MARK: - Display mode
+    
+    /// The way the banner is moved between the ad cell and the 'stick to top' view.
+    enum DisplayMode {
+        /// The banner is removed from the ad cell and added to the 'stick to top' view when it is stuck
+        /// (and the other way around when it is unstuck).
+        case reparenting
+        
+        /// The banner is permanently hosted by the 'stick to top' view, above the table view: the ad cell only
+        /// reserves the space of the ad and drives the frame of the banner.
+        ///
+        /// Stick / unstick transitions are then pure geometry updates which never detach the video rendering
+        /// layer of the banner. This mode requires a `stickToTopContainerView`, the `reparenting` mode is used
+        /// otherwise.
+        case overlay
+    }
+    
+    /// The way the banner is resized when the ad container shrinks or grows while the user scrolls.
+    enum ResizeMode {
+        /// The height constraint of the ad container is updated on each scroll event: the banner is laid out
+        /// again with its new size.
+        case constraints
+        
+        /// The banner keeps its full size layout and is scaled and cropped using a layer transform and a mask,
+        /// so scroll events only update render properties of the banner and never trigger a layout pass.
+        ///
+        /// This mode only applies when the banner is displayed inside the ad cell (`reparenting` display mode).
+        case compositing
+    }
+    
     // MARK: - Constants
     
     static let NIB_NAME = "SASVideoHeaderAdCell"
@@ -46,6 +77,8 @@ class SASVideoHeaderAdCell: UITableViewCell, SASBannerViewDelegate {
     ///
     /// @note We recommend a value of 16:9 as it is the typical video ratio, however always check
     /// that it works well for your app and that it does not make navigation too cumbersome for the user.
+    ///
+    /// This ratio is replaced by the aspect ratio of the creative once it is loaded (see `usesCreativeAspectRatio`).
     static let MAX_RATIO: CGFloat = 16.0 / 9.0
     
     /// Minimum ratio of the ad before it is removed from the table view and stuck over it.
@@ -54,6 +87,18 @@ class SASVideoHeaderAdCell: UITableViewCell, SASBannerViewDelegate {
     /// added back to the first cell of the table view.
     static let MIN_RATIO: CGFloat = 32.0 / 9.0
     
+    /// Default bounds applied to the aspect ratio of the delivered creative (see `creativeAspectRatioBounds`).
+    static let DEFAULT_CREATIVE_ASPECT_RATIO_BOUNDS: ClosedRange<CGFloat> = (4.0 / 3.0)...(21.0 / 9.0)
+    
+    /// Default hysteresis (in points) applied before unsticking the ad (see `stickHysteresis`).
+    static let DEFAULT_STICK_HYSTERESIS: CGFloat = 8.0
+    
+    /// Default minimum duration (in seconds) between two stick / unstick transitions (see `minimumStickStateDuration`).
+    static let DEFAULT_MINIMUM_STICK_STATE_DURATION: TimeInterval = 0.1
+    
+    /// Duration of the collapse animation of the ad cell when the ad is closed.
+    static let COLLAPSE_ANIMATION_DURATION: TimeInterval = 0.3
+    
     // MARK: - Public properties
     
     /// The delegate of the `SASVideoHeaderAdCell`.
@@ -66,6 +111,47 @@ class SASVideoHeaderAdCell: UITableViewCell, SASBannerViewDelegate {
     /// disappear when the user scrolls.
     weak var stickToTopContainerView: UIView? = nil
     
+    /// The way the banner is moved between the ad cell and the `stickToTopContainerView`.
+    ///
+    /// @note This value must be set before the first scroll event is forwarded to the ad cell.
+    var displayMode: DisplayMode = .reparenting
+    
+    /// The way the banner is resized while the user scrolls.
+    ///
+    /// @note This value must be set before the first scroll event is forwarded to the ad cell.
+    var resizeMode: ResizeMode = .constraints
+    
+    /// The cache in which the ad cell looks for a prefetched ad before performing an ad call.
+    ///
+    /// Set this to 'nil' to always perform an ad call when `loadAd(with:)` is called.
+    var prefetchCache: SASAdPrefetchCache? = SASAdPrefetchCache.shared
+    
+    /// The coalescer used to load the ad, so identical loads in flight share the same ad call.
+    ///
+    /// Set this to 'nil' to always perform a dedicated ad call.
+    var loadCoalescer: SASAdLoadCoalescer? = SASAdLoadCoalescer.shared
+    
+    /// The tracer recording the lifecycle of the ads loaded by the ad cell (ad call, load, first frame, stick, click
+    /// and close), aggregated by placement.
+    ///
+    /// Tracing is opt-in: set this to a tracer (for instance `SASAdLifecycleTracer.shared`) to trace the ad cell.
+    var lifecycleTracer: SASAdLifecycleTracer? = nil
+    
+    /// The policy deciding whether a failed load is retried (and when) instead of collapsing the ad cell.
+    ///
+    /// The ad cell stays expanded while a retry is pending. Set this to 'nil' to collapse the ad cell as soon as
+    /// a load fails.
+    var retryPolicy: SASAdRetryPolicy? = SASAdRetryPolicy.shared
+    
+    /// Whether the maximum size of the ad is computed from the aspect ratio of the delivered creative (when
+    /// available) instead of `MAX_RATIO`.
+    var usesCreativeAspectRatio = true
+    
+    /// Bounds applied to the aspect ratio of the delivered creative before using it as maximum ratio of the ad.
+    ///
+    /// @note Keep the upper bound lower than `MIN_RATIO`, otherwise the ad would be stuck as soon as the user scrolls.
+    var creativeAspectRatioBounds = SASVideoHeaderAdCell.DEFAULT_CREATIVE_ASPECT_RATIO_BOUNDS
+    
     /// The modal parent view controller of the current banner.
     ///
     /// @note You should always set a valid modal parent view controller, otherwise most post-click interactions
@@ -76,20 +162,112 @@ class SASVideoHeaderAdCell: UITableViewCell, SASBannerViewDelegate {
         }
     }
     
-    // MARK: - Private properties
+    /// Whether the ad cell observes the scroll events of its table view by itself.
+    ///
+    /// When enabled, the ad cell starts observing the content offset of the table view it is displayed in, so
+    /// the app doesn't need to forward its scroll events by calling `scrollViewDidScroll(offset:)`.
+    var handlesScrollEventsAutomatically = false {
+        didSet {
+            updateScrollObservation()
+        }
+    }
+    
+    /// The table view the ad cell is currently displayed in, if any.
+    ///
+    /// This reference is resolved once when the ad cell is moved to a new superview.
+    private(set) weak var enclosingTableView: UITableView? = nil
     
-    private let bannerView = { SASBannerView(frame: .zero) }()
+    /// Additional height (in points) the ad must grow over its minimum size before being unstuck and added back
+    /// to the table view.
+    ///
+    /// This prevents the banner from being moved back and forth between the table view and the 'stick to top'
+    /// view when the user drags slowly around the minimum ratio.
+    var stickHysteresis: CGFloat {
+        get { layout.hysteresis }
+        set { layout.hysteresis = newValue }
+    }
     
-    private var isStuck = false
-    private var isClosed = false
+    /// Minimum duration (in seconds) the banner stays stuck or unstuck before it can change state again.
+    var minimumStickStateDuration: TimeInterval {
+        get { layout.minimumStateDuration }
+        set { layout.minimumStateDuration = newValue }
+    }
     
-    private var maxSize: CGFloat {
-        return self.bounds.size.width / SASVideoHeaderAdCell.MAX_RATIO
+    /// Change (in points) the size of the ad must exceed before its constraints are updated during a scroll.
+    ///
+    /// The default value only skips updates that would not change anything. Set this to 'nil' to update the
+    /// constraints on every scroll event.
+    var constraintUpdateThreshold: CGFloat? {
+        get { layout.changeThreshold }
+        set { layout.changeThreshold = newValue }
     }
-    private var minSize: CGFloat {
-        return self.bounds.size.width / SASVideoHeaderAdCell.MIN_RATIO
+    
+    /// The report of the last auction run by the ad cell, if any (see `loadAd(with:)`).
+    private(set) var lastAuctionReport: SASAdAuctionLoader.Report? = nil
+    
+    /// Counters of the constraint updates and transitions performed by the ad cell, mostly useful to measure
+    /// the layout work done while scrolling.
+    var layoutCounters: SASVideoHeaderAdLayout.Counters {
+        return layout.counters
     }
     
+    // MARK: - Private properties
+    
+    private var bannerView = { SASBannerView(frame: .zero) }()
+    
+    /// The geometry engine computing the size of the ad and the stick / unstick decisions.
+    private var layout: SASVideoHeaderAdLayout = {
+        var layout = SASVideoHeaderAdLayout(
+            maxRatio: SASVideoHeaderAdCell.MAX_RATIO,
+            minRatio: SASVideoHeaderAdCell.MIN_RATIO
+        )
+        layout.hysteresis = SASVideoHeaderAdCell.DEFAULT_STICK_HYSTERESIS
+        layout.minimumStateDuration = SASVideoHeaderAdCell.DEFAULT_MINIMUM_STICK_STATE_DURATION
+        return layout
+    }()
+    
+    /// The table view whose scroll events are currently observed, if any.
+    ///
+    /// Unlike `enclosingTableView`, this reference is kept when the ad cell is removed from the table view (for
+    /// instance when it is recycled after being scrolled out of the screen) so the banner can still be unstuck.
+    private weak var observedScrollView: UIScrollView? = nil
+    
+    /// The load currently requested to the coalescer, if any.
+    private var pendingLoadRequest: SASAdLoadCoalescer.Request? = nil
+    
+    /// The waterfall currently loaded, if any.
+    private var pendingWaterfallLoader: SASAdWaterfallLoader? = nil
+    
+    /// The auction currently running, if any.
+    private var pendingAuctionLoader: SASAdAuctionLoader? = nil
+    
+    /// Whether the ad cell's own banner view is currently loading an ad (without the coalescer).
+    private var isLoadingBannerView = false
+    
+    /// The tasks awaiting the current load (see `loadAd(with:) async`).
+    private var loadContinuations = [SASAdLoadContinuation<SASAdInfo>]()
+    
+    private var contentOffsetObservation: NSKeyValueObservation? = nil
+    
+    /// The lifecycle trace of the current ad, if any.
+    private var traceID: SASAdLifecycleTracer.TraceID? = nil
+    
+    /// The placement of the current load, retried if the load fails.
+    private var adPlacement: SASAdPlacement? = nil
+    
+    /// The time at which the current load has started and the number of retries already performed.
+    private var loadStartTime: TimeInterval = 0.0
+    private var retryCount = 0
+    
+    /// The scheduled retry of the current load, if any.
+    private var retryWorkItem: DispatchWorkItem? = nil
+    
+    /// The display link waiting for the first frame displayed after the ad has been loaded, if any.
+    private var firstFrameDisplayLink: CADisplayLink? = nil
+    
+    /// The scroll event replayed once the minimum stick state duration has elapsed, if a transition has been delayed.
+    private var pendingTransitionWorkItem: DispatchWorkItem? = nil
+    
     @IBOutlet weak var adContainerView: UIView!
     @IBOutlet weak var paddingViewHeightConstraint: NSLayoutConstraint!
     @IBOutlet weak var adContainerHeightConstraint: NSLayoutConstraint!
@@ -108,49 +286,203 @@ class SASVideoHeaderAdCell: UITableViewCell, SASBannerViewDelegate {
         unstickBanner()
     }
     
+    deinit {
+        // The pending load is cancelled so the ad call can be abandoned if nobody else is waiting for it.
+        pendingLoadRequest?.cancel()
+        pendingWaterfallLoader?.cancel()
+        pendingAuctionLoader?.cancel()
+        retryWorkItem?.cancel()
+        pendingTransitionWorkItem?.cancel()
+    }
+    
     func loadAd(with adPlacement: SASAdPlacement) {
-        // Loading the ad cell simply consists in loading a banner view as in other integration case:
+        loadAd(with: adPlacement, continuation: nil)
+    }
+    
+    /**
+     Loads an ad and suspends the current task until it is loaded and displayed, or until the ad cell gives up.
+     
+     The ad cell delegate is still notified as usual. Cancelling the calling task cancels the load (including its
+     pending retries): the underlying ad call is abandoned if nobody else is waiting for it, and the method throws
+     a `CancellationError`. Starting another load of the ad cell also cancels this one, and a closed ad cell throws a
+     `CancellationError` without loading anything.
+     
+     @param adPlacement The ad placement used to load the ad.
+     @return The ad info of the loaded ad.
+     */
+    @MainActor
+    func loadAd(with adPlacement: SASAdPlacement) async throws -> SASAdInfo {
+        let continuation = SASAdLoadContinuation<SASAdInfo>()
+        return try await continuation.perform({
+            loadAd(with: adPlacement, continuation: continuation)
+        }, cancellation: { [weak self] in
+            self?.cancelPendingLoads()
+        })
+    }
+    
+    private func loadAd(with adPlacement: SASAdPlacement, continuation: SASAdLoadContinuation<SASAdInfo>?) {
+        // A closed ad cell stays collapsed: no ad call is performed, and the awaiting task is resumed right away.
+        guard !layout.isClosed else {
+            continuation?.resume(with: .failure(CancellationError()))
+            return
+        }
         
-        bannerView.delegate = self
-        bannerView.modalParentViewController = modalParentViewController
+        // A new lifecycle trace is started for each ad call.
+        traceID = lifecycleTracer?.beginTrace(placement: SASVideoHeaderAdCell.tracedPlacementName(of: adPlacement))
         
-        bannerView.loadAd(with: adPlacement)
+        // The load state is reset: the retries of a load are counted from its first ad call.
+        cancelPendingLoads()
+        if let continuation {
+            loadContinuations.append(continuation)
+        }
+        self.adPlacement = adPlacement
+        loadStartTime = CACurrentMediaTime()
+        retryCount = 0
+        retryPolicy?.loadDidStart()
+        
+        performLoad(with: adPlacement)
     }
     
-    func scrollViewDidScroll(offset: CGPoint) {
-        // No need to handle scroll events if the ad is already closed
-        guard !isClosed else { return }
+    /**
+     Loads the ad of the first step of the waterfall returning one (for instance a primary placement, then a house
+     placement, then a backfill placement).
+     
+     The steps are loaded with their own timeout, within the deadline of the waterfall. The ad cell collapses if no step
+     returns an ad: the retry policy does not apply to waterfalls.
+     */
+    func loadAd(with waterfall: SASAdWaterfall) {
+        let firstAdPlacement = waterfall.steps.first?.adPlacement
+        traceID = lifecycleTracer?.beginTrace(placement: firstAdPlacement.map(SASVideoHeaderAdCell.tracedPlacementName(of:)) ?? "")
         
+        // The state of the previous load is discarded.
+        cancelPendingLoads()
+        
+        // If an ad has been prefetched for the first step, it is displayed right away.
+        if let firstAdPlacement, let prefetchedAd = prefetchCache?.takeAd(for: firstAdPlacement) {
+            displayLoadedBannerView(prefetchedAd.bannerView, adInfo: prefetchedAd.adInfo)
+            return
+        }
+        
+        // Without coalescer, the waterfall uses a dedicated one so its ad calls are never shared.
+        let waterfallLoader = SASAdWaterfallLoader(waterfall: waterfall, coalescer: loadCoalescer ?? SASAdLoadCoalescer())
+        pendingWaterfallLoader = waterfallLoader
+        waterfallLoader.load { [weak self] result in
+            guard let self else { return }
+            self.pendingWaterfallLoader = nil
+            
+            switch result {
+            case .success(let winner):
+                self.displayLoadedBannerView(winner.ad.ad, adInfo: winner.ad.adInfo)
+            case .failure(let error):
+                self.bannerView(self.bannerView, didFailToLoad: error)
+            }
+        }
+    }
+    
+    /**
+     Loads the placements of the auction concurrently and displays the ad with the best cleared price.
+     
+     Only the winning banner is attached to the ad cell, the other ads being released as soon as they are beaten.
+     The report of the auction (latency and memory high-water mark) is then available in `lastAuctionReport`.
+     */
+    func loadAd(with auction: SASAdAuction) {
+        let firstAdPlacement = auction.adPlacements.first
+        traceID = lifecycleTracer?.beginTrace(placement: firstAdPlacement.map(SASVideoHeaderAdCell.tracedPlacementName(of:)) ?? "")
+        
+        // The state of the previous load is discarded.
+        cancelPendingLoads()
+        
+        // The ad calls of the auction are performed by the loader of the coalescer, without being coalesced.
+        let auctionLoader = SASAdAuctionLoader(auction: auction, loader: loadCoalescer?.loader ?? SASAdSDKLoader.shared)
+        pendingAuctionLoader = auctionLoader
+        auctionLoader.load(modalParentViewController: modalParentViewController) { [weak self] result, report in
+            guard let self else { return }
+            self.pendingAuctionLoader = nil
+            self.lastAuctionReport = report
+            
+            switch result {
+            case .success(let winner):
+                self.displayLoadedBannerView(winner.bannerView, adInfo: winner.adInfo)
+            case .failure(let error):
+                self.bannerView(self.bannerView, didFailToLoad: error)
+            }
+        }
+    }
+    
+    func scrollViewDidScroll(offset: CGPoint) {
         // This method handles the table view scroll events:
         
-        // The size of the ad container is computed depending on the vertical offset of the table view
-        // and the maximum size the ad cell can use.
-        let adContainerHeight = maxSize - offset.y
+        // The banner can only be stuck if a 'stick to top' view has been defined.
+        layout.canStick = stickToTopContainerView != nil
+        
+        // In overlay mode, the banner is moved to the 'stick to top' view once and for all.
+        if isOverlayModeEnabled {
+            attachBannerToOverlayHost()
+        }
+        
+        // The size of the ad container and the stick / unstick decision are computed by the layout engine
+        // depending on the width of the cell and the vertical offset of the table view.
+        let commands = layout.scrollViewDidScroll(
+            width: self.bounds.size.width,
+            offset: offset.y,
+            timestamp: CACurrentMediaTime()
+        )
+        
+        // A transition delayed by the minimum state duration is emitted once it has elapsed, by replaying the last
+        // scroll event (the user may have stopped scrolling in the meantime).
+        schedulePendingTransition(at: commands.pendingTransitionTimestamp)
+        
+        // The stick transitions are traced (only the first one of each ad is aggregated by the tracer).
+        if commands.transition == .stick {
+            lifecycleTracer?.record(.stick, trace: traceID)
+        }
         
         // Then the banner is displayed either inline in the table view or over it depending on
-        // the computed size.
-        if adContainerHeight > minSize {
-            // If the banner height is higher than the minimum size:
-            // The banner is unstick if necessary (aka added back to the table view).
-            if isStuck {
-                unstickBanner()
+        // the computed commands.
+        // In overlay mode, transitions are handled by the overlay frame update below.
+        switch commands.transition {
+        case .stick where !isOverlayModeEnabled:
+            // The banner is stuck (aka it is removed from the superview and displayed over it,
+            // inside the `stickToTopContainerView`).
+            stickBanner(height: commands.stuckHeight!)
+        case .unstick where !isOverlayModeEnabled:
+            // The banner is unstuck (aka added back to the table view).
+            unstickBanner()
+        case .none where !isOverlayModeEnabled:
+            // The height of a banner already stuck can change if the ratios of the ad have changed.
+            if let stuckHeight = commands.stuckHeight {
+                bannerHeightConstraint?.constant = stuckHeight
             }
-
-            // The size of the ad is set using the value computed at the start of the method
-            adContainerHeightConstraint.constant = CGFloat(adContainerHeight)
-            
-            // A padding is added so the ad container stays in the bottom part of the ad cell:
-            // this allows the banner view to be always 100% visible.
-            paddingViewHeightConstraint.constant = CGFloat(maxSize)
-        } else {
-            // If the banner height is smaller than the minimum size:
-            
-            // The banner is stuck if necessary (aka it is removed from the superview and displayed
-            // over it, inside the `stickToTopContainerView`).
-            if !isStuck {
-                stickBanner()
+        default:
+            break
+        }
+        
+        // The size of the ad is set using the value computed by the layout engine (only if it has changed
+        // since the last scroll event, so Auto Layout is not invalidated needlessly).
+        if isCompositedResizeEnabled {
+            // In compositing mode, the ad container keeps its maximum size and the banner is scaled instead.
+            if commands.adContainerHeight != nil || commands.transition == .unstick {
+                updateCompositedResize()
+            }
+        } else if let adContainerHeight = commands.adContainerHeight {
+            adContainerHeightConstraint.constant = adContainerHeight
+        }
+        
+        // A padding is added so the ad container stays in the bottom part of the ad cell:
+        // this allows the banner view to be always 100% visible.
+        if let paddingHeight = commands.paddingHeight {
+            paddingViewHeightConstraint.constant = paddingHeight
+            if isCompositedResizeEnabled {
+                adContainerHeightConstraint.constant = paddingHeight
+                updateCompositedResize()
             }
         }
+        
+        // In overlay mode, the banner frame follows the ad container (or the top of the 'stick to top' view
+        // when stuck).
+        if isOverlayModeEnabled {
+            updateOverlayBannerFrame()
+        }
     }
     
     func closeAd() {
@@ -168,8 +500,17 @@ class SASVideoHeaderAdCell: UITableViewCell, SASBannerViewDelegate {
         adContainerHeightConstraint.constant = CGFloat(0.0)
         reloadAdCell()
         
-        // A flag is raised so the ad cell stops processing the scroll event.
-        isClosed = true
+        // The layout is closed so the ad cell stops processing the scroll event.
+        layout.close()
+        
+        lifecycleTracer?.record(.close, trace: traceID)
+        
+        // The loads still in progress are cancelled (the tasks awaiting them throw a `CancellationError`).
+        cancelPendingLoads()
+        pendingTransitionWorkItem?.cancel()
+        pendingTransitionWorkItem = nil
+        firstFrameDisplayLink?.invalidate()
+        firstFrameDisplayLink = nil
         
         // Call the delegate, if any.
         delegate?.videoHeaderAdCellDidClose(self)
@@ -177,10 +518,42 @@ class SASVideoHeaderAdCell: UITableViewCell, SASBannerViewDelegate {
     
     // MARK: - Internal view management
     
+    override func didMoveToSuperview() {
+        super.didMoveToSuperview()
+        
+        // The enclosing table view is resolved again each time the view hierarchy changes.
+        enclosingTableView = findEnclosingTableView()
+        updateScrollObservation()
+    }
+    
     /**
-     This util method is used to retrieve the current table view the ad cell is displayed in.
+     This util method replays the last scroll event at the given time, when the layout has delayed a stick state
+     transition until the minimum duration of the current state has elapsed.
+     
+     @param timestamp The time at which the delayed transition can happen, or nil to cancel the pending replay.
      */
+    private func schedulePendingTransition(at timestamp: TimeInterval?) {
+        pendingTransitionWorkItem?.cancel()
+        pendingTransitionWorkItem = nil
+        guard let timestamp else { return }
+        
+        let workItem = DispatchWorkItem { [weak self] in
+            guard let self, !self.layout.isClosed else { return }
+            self.pendingTransitionWorkItem = nil
+            self.scrollViewDidScroll(offset: CGPoint(x: 0.0, y: self.layout.lastOffset))
+        }
+        pendingTransitionWorkItem = workItem
+        DispatchQueue.main.asyncAfter(deadline: .now() + max(timestamp - CACurrentMediaTime(), 0.0), execute: workItem)
+    }
+    
     private func currentTableView() -> UITableView? {
+        return enclosingTableView
+    }
+    
+    /**
+     This util method is used to retrieve the current table view the ad cell is displayed in.
+     */
+    private func findEnclosingTableView() -> UITableView? {
         var view = self.superview
         while view != nil {
             if let tableView = view as? UITableView {
@@ -192,88 +565,438 @@ class SASVideoHeaderAdCell: UITableViewCell, SASBannerViewDelegate {
     }
     
     /**
-     This util method is used to reload table view the ad cell is displayed in.
+     This util method starts or stops observing the scroll events of the enclosing table view.
+     */
+    private func updateScrollObservation() {
+        guard handlesScrollEventsAutomatically else {
+            contentOffsetObservation = nil
+            observedScrollView = nil
+            return
+        }
+        
+        // The observation is only replaced if the ad cell has been moved to another table view.
+        guard let tableView = enclosingTableView, tableView !== observedScrollView else { return }
+        
+        observedScrollView = tableView
+        contentOffsetObservation = tableView.observe(\.contentOffset, options: [.initial, .new]) { [weak self] scrollView, _ in
+            self?.scrollViewDidScroll(offset: scrollView.contentOffset)
+        }
+    }
+    
+    /**
+     This util method is used to reload the height of the ad cell in the table view it is displayed in.
+     
+     When the table view supports self-sizing invalidation, only the height of the ad cell is invalidated
+     (and the change animated if requested) so the other rows of the table view are not measured again.
+     Otherwise the whole table view is updated.
      */
-    private func reloadAdCell() {
-        if let tableView = currentTableView() {
+    private func reloadAdCell(animated: Bool = true) {
+        guard let tableView = currentTableView() else { return }
+        
+        if tableView.selfSizingInvalidation != .disabled {
+            let updates = {
+                self.invalidateIntrinsicContentSize()
+                tableView.layoutIfNeeded()
+            }
+            if animated {
+                UIView.animate(withDuration: SASVideoHeaderAdCell.COLLAPSE_ANIMATION_DURATION, animations: updates)
+            } else {
+                UIView.performWithoutAnimation(updates)
+            }
+        } else {
             tableView.beginUpdates()
             tableView.endUpdates()
         }
     }
     
+    /// Constraints used when the banner is displayed inline, inside the ad container view.
+    ///
+    /// These constraints are built only once per banner view since the ad container view never changes.
+    private lazy var inlineConstraints: [NSLayoutConstraint] = makeInlineConstraints()
+    
+    private func makeInlineConstraints() -> [NSLayoutConstraint] {
+        return [
+            bannerView.leadingAnchor.constraint(equalTo: adContainerView.leadingAnchor),
+            bannerView.trailingAnchor.constraint(equalTo: adContainerView.trailingAnchor),
+            bannerView.topAnchor.constraint(equalTo: adContainerView.topAnchor),
+            bannerView.bottomAnchor.constraint(equalTo: adContainerView.bottomAnchor),
+        ]
+    }
+    
+    /// Constraints used when the banner is stuck over the table view, built once per 'stick to top' view.
+    private var stuckConstraints: [NSLayoutConstraint] = []
+    
+    /// The 'stick to top' view used to build the current stuck constraints.
+    private weak var stuckConstraintsContainerView: UIView? = nil
+    
+    /// The hardcoded height constraint of the banner when it is stuck (part of the stuck constraints).
     private var bannerHeightConstraint: NSLayoutConstraint? = nil
     
-    private func stickBanner() {
+    /**
+     Returns the stuck constraints for the given 'stick to top' view, building them only if this view has changed
+     since the last call.
+     */
+    private func stuckConstraints(for mainView: UIView) -> [NSLayoutConstraint] {
+        if stuckConstraintsContainerView !== mainView || stuckConstraints.isEmpty {
+            NSLayoutConstraint.deactivate(stuckConstraints)
+            
+            let heightConstraint = bannerView.heightAnchor.constraint(equalToConstant: 0.0)
+            stuckConstraints = [
+                bannerView.leadingAnchor.constraint(equalTo: mainView.safeAreaLayoutGuide.leadingAnchor),
+                bannerView.trailingAnchor.constraint(equalTo: mainView.safeAreaLayoutGuide.trailingAnchor),
+                bannerView.topAnchor.constraint(equalTo: mainView.safeAreaLayoutGuide.topAnchor),
+                heightConstraint,
+            ]
+            bannerHeightConstraint = heightConstraint
+            stuckConstraintsContainerView = mainView
+        }
+        return stuckConstraints
+    }
+    
+    private func stickBanner(height: CGFloat) {
         // No need to stick the banner if it is already closed or there is no `stickToTopContainerView` defined
-        guard !isClosed else { return }
+        guard !layout.isClosed else { return }
         guard let mainView = stickToTopContainerView else { return }
         
+        let constraints = stuckConstraints(for: mainView)
+        
+        // Any transform set by the compositing resize mode is removed since the stuck banner has a fixed size.
+        bannerView.layer.setAffineTransform(.identity)
+        
         // The banner view is removed from its parent (the table view) and added to the 'stick to top' view.
+        NSLayoutConstraint.deactivate(inlineConstraints)
         bannerView.removeFromSuperview()
         mainView.addSubview(bannerView)
         
         // The banner height is now harcoded to the minimum size as user scrolls are ignored as long as the
         // banner view is stuck over the table view.
-        bannerHeightConstraint = bannerView.heightAnchor.constraint(equalToConstant: minSize)
+        bannerHeightConstraint?.constant = height
         
-        // New constraints are applied on the banner view:
-        // including the hardcoded height constraint defined above.
+        // The prebuilt stuck constraints are applied on the banner view, including the hardcoded height
+        // constraint defined above.
         bannerView.translatesAutoresizingMaskIntoConstraints = false
-        NSLayoutConstraint.activate([
-            bannerView.leadingAnchor.constraint(equalTo: mainView.safeAreaLayoutGuide.leadingAnchor),
-            bannerView.trailingAnchor.constraint(equalTo: mainView.safeAreaLayoutGuide.trailingAnchor),
-            bannerView.topAnchor.constraint(equalTo: mainView.safeAreaLayoutGuide.topAnchor),
-            bannerHeightConstraint!,
-        ])
-        
-        // A flag is set so the scroll events are processed properly
-        isStuck = true
+        NSLayoutConstraint.activate(constraints)
     }
     
     private func unstickBanner() {
         // No need to unstick the banner if it is already closed
-        guard !isClosed else { return }
+        guard !layout.isClosed else { return }
         
-        // The banner view is removed from its parent (the 'stick to top' view) and added to the container of the ad cell
+        // The banner view is removed from its parent (the 'stick to top' view) and added to the container of the ad cell.
+        // The stuck constraints (including the hardcoded height constraint) are deactivated but kept for the next
+        // time the banner is stuck.
+        NSLayoutConstraint.deactivate(stuckConstraints)
         bannerView.removeFromSuperview()
         adContainerView.addSubview(bannerView)
         
-        // The manual height constraint set when the banner was stuck is removed and destroyed.
-        if let constraint = bannerHeightConstraint {
-            bannerView.removeConstraint(constraint)
-            bannerHeightConstraint = nil
-        }
-        
-        // New constraints are applied on the banner view:
+        // The prebuilt inline constraints are applied on the banner view:
         // The banner will simply occupy the whole ad container view (whose size is already computed properly
         // in the method that handles scroll events).
         bannerView.translatesAutoresizingMaskIntoConstraints = false
-        NSLayoutConstraint.activate([
-            bannerView.leadingAnchor.constraint(equalTo: adContainerView.leadingAnchor),
-            bannerView.trailingAnchor.constraint(equalTo: adContainerView.trailingAnchor),
-            bannerView.topAnchor.constraint(equalTo: adContainerView.topAnchor),
-            bannerView.bottomAnchor.constraint(equalTo: adContainerView.bottomAnchor),
-        ])
+        NSLayoutConstraint.activate(inlineConstraints)
+    }
+    
+    // MARK: - Ad loading
+    
+    /**
+     Cancels the loads in progress (single placement and its retries, waterfall or auction), if any.
+     */
+    private func cancelPendingLoads() {
+        adPlacement = nil
+        retryWorkItem?.cancel()
+        retryWorkItem = nil
+        pendingLoadRequest?.cancel()
+        pendingLoadRequest = nil
+        pendingWaterfallLoader?.cancel()
+        pendingWaterfallLoader = nil
+        pendingAuctionLoader?.cancel()
+        pendingAuctionLoader = nil
+        
+        // The ad cell's banner view stops reporting the ad call it is performing, if any.
+        if isLoadingBannerView {
+            isLoadingBannerView = false
+            bannerView.delegate = nil
+        }
+        
+        // The tasks awaiting the cancelled load are resumed.
+        resumeLoadContinuations(with: .failure(CancellationError()))
+    }
+    
+    private func performLoad(with adPlacement: SASAdPlacement) {
+        // If an ad has been prefetched for this placement, its banner view is adopted by the ad cell
+        // and no ad call is performed.
+        if let prefetchedAd = prefetchCache?.takeAd(for: adPlacement) {
+            displayLoadedBannerView(prefetchedAd.bannerView, adInfo: prefetchedAd.adInfo)
+            return
+        }
+        
+        // If a coalescer is available, the ad is loaded through it: if an identical load is already in flight
+        // (a prefetch or another ad cell), the ad cell is attached to it instead of performing a new ad call.
+        if let loadCoalescer {
+            pendingLoadRequest?.cancel()
+            pendingLoadRequest = loadCoalescer.loadBannerView(with: adPlacement) { [weak self] result in
+                guard let self else { return }
+                self.pendingLoadRequest = nil
+                
+                switch result {
+                case .success(let ad) where ad.claim():
+                    self.displayLoadedBannerView(ad.ad, adInfo: ad.adInfo)
+                case .success:
+                    // The ad has already been claimed by another waiter: a dedicated ad call is performed.
+                    self.loadBannerView(with: adPlacement)
+                case .failure(let error):
+                    self.bannerView(self.bannerView, didFailToLoad: error)
+                }
+            }
+            return
+        }
+        
+        loadBannerView(with: adPlacement)
+    }
+    
+    private func loadBannerView(with adPlacement: SASAdPlacement) {
+        // Loading the ad cell simply consists in loading a banner view as in other integration case:
+        
+        bannerView.delegate = self
+        bannerView.modalParentViewController = modalParentViewController
+        
+        isLoadingBannerView = true
+        bannerView.loadAd(with: adPlacement)
+    }
+    
+    private func displayLoadedBannerView(_ loadedBannerView: SASBannerView, adInfo: SASAdInfo) {
+        // The banner view loaded elsewhere is adopted by the ad cell, then handled as if the ad cell had loaded it.
+        adoptBannerView(loadedBannerView)
+        bannerView.delegate = self
+        bannerView.modalParentViewController = modalParentViewController
+        bannerView(bannerView, didLoadWith: adInfo)
+    }
+    
+    // MARK: - Loaded banner adoption
+    
+    private func adoptBannerView(_ newBannerView: SASBannerView) {
+        guard !layout.isClosed, newBannerView !== bannerView else { return }
+        
+        // The current banner view and all its constraints are discarded.
+        NSLayoutConstraint.deactivate(inlineConstraints)
+        NSLayoutConstraint.deactivate(stuckConstraints)
+        bannerView.delegate = nil
+        bannerView.removeFromSuperview()
+        
+        // The new banner view gets its own constraints, built for it.
+        bannerView = newBannerView
+        inlineConstraints = makeInlineConstraints()
+        stuckConstraints = []
+        stuckConstraintsContainerView = nil
+        bannerHeightConstraint = nil
+        
+        // The new banner view is then displayed in the same state as the previous one.
+        if isOverlayModeEnabled {
+            attachBannerToOverlayHost()
+            updateOverlayBannerFrame()
+        } else if layout.isStuck, let stuckHeight = layout.appliedStuckHeight {
+            stickBanner(height: stuckHeight)
+        } else {
+            unstickBanner()
+            if isCompositedResizeEnabled {
+                updateCompositedResize()
+            }
+        }
+    }
+    
+    // MARK: - Compositing resize mode
+    
+    /// Whether the banner is resized using the compositing mode.
+    private var isCompositedResizeEnabled: Bool {
+        return resizeMode == .compositing && !isOverlayModeEnabled
+    }
+    
+    /// The mask cropping the banner to the visible part of the ad container in compositing mode.
+    private lazy var adContainerMaskLayer: CALayer = {
+        let layer = CALayer()
+        layer.backgroundColor = UIColor.black.cgColor
+        return layer
+    }()
+    
+    private func updateCompositedResize() {
+        guard !layout.isStuck, let adContainerHeight = layout.appliedAdContainerHeight else { return }
+        
+        let width = self.bounds.size.width
+        let maxSize = layout.maxSize(width: width)
+        guard maxSize > 0.0 else { return }
+        
+        // The banner (laid out with the maximum size) is scaled to the computed height, then moved so it stays at
+        // the bottom of the ad container, exactly where a banner of the computed height would have been laid out.
+        let scale = adContainerHeight / maxSize
+        let translation = (maxSize - adContainerHeight) / 2.0
+        let transform = CGAffineTransform(translationX: 0.0, y: translation).scaledBy(x: scale, y: scale)
+        
+        // Implicit animations are disabled so the banner follows the scroll immediately.
+        CATransaction.begin()
+        CATransaction.setDisableActions(true)
+        bannerView.layer.setAffineTransform(transform)
+        adContainerMaskLayer.frame = CGRect(x: 0.0, y: maxSize - adContainerHeight, width: width, height: adContainerHeight)
+        if adContainerView.layer.mask !== adContainerMaskLayer {
+            adContainerView.layer.mask = adContainerMaskLayer
+        }
+        CATransaction.commit()
+    }
+    
+    // MARK: - Overlay mode
+    
+    /// Whether the banner is displayed using the overlay mode.
+    private var isOverlayModeEnabled: Bool {
+        return displayMode == .overlay && stickToTopContainerView != nil
+    }
+    
+    private func attachBannerToOverlayHost() {
+        // No need to attach the banner if it is already closed or already hosted by the 'stick to top' view
+        guard !layout.isClosed else { return }
+        guard let mainView = stickToTopContainerView, bannerView.superview !== mainView else { return }
+        
+        // The banner view is moved to the 'stick to top' view: this is the only time the banner view is reparented
+        // in overlay mode. Its frame is then set manually on each scroll event, without any constraint.
+        NSLayoutConstraint.deactivate(inlineConstraints)
+        NSLayoutConstraint.deactivate(stuckConstraints)
+        bannerView.removeFromSuperview()
+        mainView.addSubview(bannerView)
+        bannerView.translatesAutoresizingMaskIntoConstraints = true
+    }
+    
+    private func updateOverlayBannerFrame() {
+        guard let mainView = stickToTopContainerView, bannerView.superview === mainView else { return }
+        
+        if layout.isStuck, let stuckHeight = layout.appliedStuckHeight {
+            // When stuck, the banner is displayed on top of the safe area of the 'stick to top' view.
+            let safeAreaFrame = mainView.safeAreaLayoutGuide.layoutFrame
+            bannerView.frame = CGRect(x: safeAreaFrame.minX, y: safeAreaFrame.minY, width: safeAreaFrame.width, height: stuckHeight)
+        } else if let adContainerHeight = layout.appliedAdContainerHeight {
+            // Otherwise the banner covers the ad container, which is always at the bottom of the ad cell.
+            let maxSize = layout.maxSize(width: self.bounds.size.width)
+            let adContainerFrame = CGRect(x: 0.0, y: maxSize - adContainerHeight, width: self.bounds.size.width, height: adContainerHeight)
+            bannerView.frame = self.convert(adContainerFrame, to: mainView)
+        }
+    }
+    
+    // MARK: - Creative aspect ratio
+    
+    private func applyCreativeAspectRatio(of adInfo: SASAdInfo) {
+        guard usesCreativeAspectRatio, !layout.isClosed else { return }
+        guard let aspectRatio = adInfo.aspectRatio?.doubleValue, aspectRatio.isFinite, aspectRatio > 0.0 else { return }
         
-        isStuck = false
+        // The maximum ratio is the creative ratio clamped by the configured bounds. The minimum ratio can never
+        // be lower than the maximum one.
+        let maxRatio = min(max(CGFloat(aspectRatio), creativeAspectRatioBounds.lowerBound), creativeAspectRatioBounds.upperBound)
+        let minRatio = max(SASVideoHeaderAdCell.MIN_RATIO, maxRatio)
+        guard maxRatio != layout.maxRatio || minRatio != layout.minRatio else { return }
+        
+        // The new sizes are computed and applied for the current scroll offset, then the height of the ad cell
+        // is updated in a single layout pass, before the creative is displayed.
+        layout.updateRatios(maxRatio: maxRatio, minRatio: minRatio)
+        scrollViewDidScroll(offset: CGPoint(x: 0.0, y: layout.lastOffset))
+        reloadAdCell(animated: false)
+    }
+    
+    // MARK: - Retries
+    
+    /**
+     Schedules a retry of the current load if the retry policy allows it.
+     
+     @return true if a retry has been scheduled, false if the ad cell must give up.
+     */
+    private func scheduleRetry(after error: any Error) -> Bool {
+        guard let retryPolicy, let adPlacement, !layout.isClosed else { return false }
+        
+        let elapsedTime = CACurrentMediaTime() - loadStartTime
+        guard case .retry(let delay) = retryPolicy.decision(after: error, retry: retryCount, elapsedTime: elapsedTime) else { return false }
+        
+        retryCount += 1
+        let workItem = DispatchWorkItem { [weak self] in
+            guard let self, !self.layout.isClosed else { return }
+            self.retryWorkItem = nil
+            self.performLoad(with: adPlacement)
+        }
+        retryWorkItem = workItem
+        DispatchQueue.main.asyncAfter(deadline: .now() + delay, execute: workItem)
+        return true
+    }
+    
+    // MARK: - Swift concurrency
+    
+    private func resumeLoadContinuations(with result: Result<SASAdInfo, any Error>) {
+        let continuations = loadContinuations
+        loadContinuations.removeAll()
+        continuations.forEach { $0.resume(with: result) }
+    }
+    
+    // MARK: - Lifecycle tracing
+    
+    /**
+     Returns the name under which the traces of a placement are aggregated.
+     */
+    private static func tracedPlacementName(of adPlacement: SASAdPlacement) -> String {
+        return "\(adPlacement.siteId)/\(adPlacement.pageId)/\(adPlacement.formatId)"
+    }
+    
+    private func traceFirstFrame() {
+        guard lifecycleTracer != nil, traceID != nil else { return }
+        
+        // The first frame is the first display refresh following the layout pass in which the ad is displayed.
+        firstFrameDisplayLink?.invalidate()
+        firstFrameDisplayLink = CADisplayLink(target: self, selector: #selector(firstFrameDisplayed))
+        firstFrameDisplayLink?.add(to: .main, forMode: .common)
+    }
+    
+    @objc private func firstFrameDisplayed() {
+        firstFrameDisplayLink?.invalidate()
+        firstFrameDisplayLink = nil
+        lifecycleTracer?.record(.firstFrame, trace: traceID)
     }
     
     // MARK: - Banner view delegate
     
     func bannerView(_ bannerView: SASBannerView, didLoadWith adInfo: SASAdInfo) {
+        isLoadingBannerView = false
+        
+        // An ad returned after the ad cell has been closed is ignored: the ad cell stays collapsed, and the tasks
+        // still awaiting it are resumed like when the ad cell is closed.
+        guard !layout.isClosed else {
+            resumeLoadContinuations(with: .failure(CancellationError()))
+            return
+        }
+        
+        lifecycleTracer?.record(.didLoad, trace: traceID)
+        
+        // The ad cell is resized using the aspect ratio of the delivered creative, if any
+        applyCreativeAspectRatio(of: adInfo)
+        traceFirstFrame()
+        
         // Forwarding the banner view delegate call to the ad cell delegate
         delegate?.videoHeaderAdCell(self, didLoadWith: adInfo)
+        resumeLoadContinuations(with: .success(adInfo))
     }
     
     func bannerView(_ bannerView: SASBannerView, didFailToLoad error: any Error) {
+        isLoadingBannerView = false
+        
+        // The load is retried if the retry policy allows it: the ad cell stays expanded in the meantime
+        if scheduleRetry(after: error) {
+            return
+        }
+        
+        lifecycleTracer?.record(.didFailToLoad, trace: traceID)
+        
         // Forwarding the banner view delegate call to the ad cell delegate
         delegate?.videoHeaderAdCell(self, didFailToLoad: error)
+        resumeLoadContinuations(with: .failure(error))
         
         // The ad cell must be closed if no ad can be loaded
         closeAd()
     }
     
     func bannerViewClicked(_ bannerView: SASBannerView) {
+        lifecycleTracer?.record(.click, trace: traceID)
+        
         // Forwarding the banner view delegate call to the ad cell delegate
         delegate?.videoHeaderAdCellClicked(self)
     }
@@ -0,0 +1,321 @@
+//
+//  SASVideoHeaderAdLayout.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import Foundation
+
+/**
+ Geometry engine of the video header ad.
+
+ This value type contains all the size computations and the stick / unstick decision used by the
+ `SASVideoHeaderAdCell`, without any dependency to UIKit: it takes the width of the ad cell and the vertical
+ offset of the table view as input and emits the layout commands the cell must apply on its views.
+
+ Keeping this logic isolated allows it to be measured or reused outside of an actual table view.
+ */
+struct SASVideoHeaderAdLayout {
+
+    // MARK: - Layout commands
+
+    /// Transition of the banner between its inline and stuck states.
+    enum Transition: Equatable {
+        /// The banner stays in its current state.
+        case none
+
+        /// The banner must be removed from the ad cell and stuck over the table view.
+        case stick
+
+        /// The banner must be added back to the ad cell.
+        case unstick
+    }
+
+    /// Layout commands emitted for a given scroll event.
+    ///
+    /// Any height left to `nil` must not be applied by the ad cell.
+    struct Commands: Equatable {
+        /// The transition that must be applied before updating the heights.
+        var transition: Transition = .none
+
+        /// The new height of the ad container view.
+        var adContainerHeight: CGFloat? = nil
+
+        /// The new height of the padding view, which keeps the ad container in the bottom part of the ad cell.
+        var paddingHeight: CGFloat? = nil
+
+        /// The height of the banner when it is stuck over the table view.
+        var stuckHeight: CGFloat? = nil
+
+        /// The timestamp from which the transition delayed by the minimum state duration can be emitted, if any.
+        ///
+        /// The ad cell must process a scroll event again at this time (with the last offset), so the delayed
+        /// transition is emitted even if the user has stopped scrolling in the meantime.
+        var pendingTransitionTimestamp: TimeInterval? = nil
+
+        /// Commands that don't require any change on the views.
+        static let none = Commands()
+    }
+
+    /// Counters describing the work requested by the layout engine since its creation.
+    struct Counters: Equatable {
+        /// Number of scroll events processed.
+        var scrollEvents = 0
+
+        /// Number of ad container height updates emitted.
+        var adContainerHeightWrites = 0
+
+        /// Number of padding height updates emitted.
+        var paddingHeightWrites = 0
+
+        /// Number of updates skipped because the value did not change enough.
+        var skippedWrites = 0
+
+        /// Number of stick / unstick transitions emitted.
+        var transitions = 0
+
+        /// Number of stick / unstick transitions delayed because of the minimum state duration.
+        var delayedTransitions = 0
+
+        /// Total number of constraint updates emitted.
+        var constraintWrites: Int {
+            return adContainerHeightWrites + paddingHeightWrites
+        }
+
+        /// Returns the average number of constraint updates per second over the given duration.
+        func constraintWritesPerSecond(over duration: TimeInterval) -> Double {
+            guard duration > 0 else { return 0 }
+            return Double(constraintWrites) / duration
+        }
+    }
+
+    // MARK: - Properties
+
+    /// Maximum ratio of the ad (see `SASVideoHeaderAdCell.MAX_RATIO`).
+    private(set) var maxRatio: CGFloat
+
+    /// Minimum ratio of the ad before it is stuck (see `SASVideoHeaderAdCell.MIN_RATIO`).
+    private(set) var minRatio: CGFloat
+
+    /// Vertical offset of the last scroll event processed.
+    private(set) var lastOffset: CGFloat = 0.0
+
+    /// Whether the banner can be stuck over the table view, aka if a container view is available for it.
+    var canStick = true
+
+    /// Whether the banner is currently stuck over the table view.
+    private(set) var isStuck = false
+
+    /// Whether the ad has been closed: no command will be emitted anymore in this case.
+    private(set) var isClosed = false
+
+    /// The transition delayed by the minimum state duration during the last scroll event, if any.
+    private(set) var pendingTransition: Transition = .none
+
+    /// Change (in points) a height must exceed compared to the last emitted value before a new update
+    /// is emitted for it.
+    ///
+    /// The default value only skips updates that would not change anything. A sub-pixel value can be set to skip
+    /// updates that would not be visible on screen, and 'nil' disables the change-only mode entirely: every height
+    /// is then emitted on each scroll event.
+    var changeThreshold: CGFloat? = 0.0
+
+    /// Additional height (in points) the ad must grow over its minimum size before being unstuck.
+    ///
+    /// This hysteresis band prevents the banner from flapping between its inline and stuck states when the
+    /// user drags slowly (or rubber-bands) around the minimum ratio.
+    var hysteresis: CGFloat = 0.0
+
+    /// Minimum duration (in seconds) the banner must stay in its inline or stuck state before a new transition
+    /// can be emitted.
+    var minimumStateDuration: TimeInterval = 0.0
+
+    /// Timestamp of the last transition emitted, if any.
+    private var lastTransitionTimestamp: TimeInterval? = nil
+
+    /// Counters of the work requested since the layout creation.
+    private(set) var counters = Counters()
+
+    /// Last ad container height emitted, if any.
+    private var lastAdContainerHeight: CGFloat? = nil
+
+    /// Height of the ad container as currently applied on the ad cell, if any.
+    var appliedAdContainerHeight: CGFloat? {
+        return lastAdContainerHeight
+    }
+
+    /// Height of the banner when it is stuck, as emitted by the last stick transition.
+    private(set) var appliedStuckHeight: CGFloat? = nil
+
+    /// Whether the stuck height must be emitted again on the next scroll event (after a ratio change).
+    private var needsStuckHeightUpdate = false
+
+    /// Last padding height emitted, if any.
+    private var lastPaddingHeight: CGFloat? = nil
+
+    // MARK: - Initialization
+
+    init(maxRatio: CGFloat, minRatio: CGFloat) {
+        self.maxRatio = maxRatio
+        self.minRatio = minRatio
+    }
+
+    // MARK: - Sizes
+
+    /// Returns the maximum size of the ad for the given width.
+    func maxSize(width: CGFloat) -> CGFloat {
+        return width / maxRatio
+    }
+
+    /// Returns the minimum size of the ad for the given width.
+    func minSize(width: CGFloat) -> CGFloat {
+        return width / minRatio
+    }
+
+    // MARK: - Scroll handling
+
+    /**
+     Computes the layout commands for a scroll event.
+
+     @param width The current width of the ad cell.
+     @param offset The current vertical offset of the table view.
+     @param timestamp The monotonic timestamp of the scroll event (in seconds), used to enforce the minimum state duration.
+     @return The layout commands that must be applied by the ad cell.
+     */
+    mutating func scrollViewDidScroll(width: CGFloat, offset: CGFloat, timestamp: TimeInterval = 0.0) -> Commands {
+        // No need to handle scroll events if the ad is already closed
+        guard !isClosed else { return .none }
+
+        counters.scrollEvents += 1
+        lastOffset = offset
+
+        let maxSize = maxSize(width: width)
+        let minSize = minSize(width: width)
+
+        // The size of the ad container is computed depending on the vertical offset of the table view
+        // and the maximum size the ad cell can use.
+        let adContainerHeight = maxSize - offset
+
+        var commands = Commands()
+        pendingTransition = .none
+
+        // The banner is unstuck only when its height grows over the hysteresis band, and stuck as soon as its
+        // height is smaller than the minimum size.
+        if isStuck && adContainerHeight > minSize + hysteresis {
+            if canTransition(.unstick, at: timestamp, commands: &commands) {
+                commands.transition = .unstick
+                registerTransition(at: timestamp)
+                needsStuckHeightUpdate = false
+                isStuck = false
+            }
+        } else if !isStuck && adContainerHeight <= minSize && canStick {
+            if canTransition(.stick, at: timestamp, commands: &commands) {
+                // The banner is stuck with a height hardcoded to the minimum size.
+                commands.transition = .stick
+                commands.stuckHeight = minSize
+                appliedStuckHeight = minSize
+                registerTransition(at: timestamp)
+                needsStuckHeightUpdate = false
+                isStuck = true
+            }
+        }
+
+        // If the ratios have changed while the banner is stuck, its stuck height is updated.
+        if isStuck && needsStuckHeightUpdate {
+            commands.stuckHeight = minSize
+            appliedStuckHeight = minSize
+            needsStuckHeightUpdate = false
+        }
+
+        // While its stick is delayed, the banner stays inline at its minimum size.
+        let inlineHeight = pendingTransition == .stick ? max(adContainerHeight, minSize) : adContainerHeight
+
+        if inlineHeight > minSize || pendingTransition == .stick {
+            // If the banner height is higher than the minimum size, the ad container is resized.
+            // Only the heights that actually changed since the last update are emitted.
+            if shouldEmit(inlineHeight, lastValue: lastAdContainerHeight) {
+                commands.adContainerHeight = inlineHeight
+                lastAdContainerHeight = inlineHeight
+                counters.adContainerHeightWrites += 1
+            } else {
+                counters.skippedWrites += 1
+            }
+            if shouldEmit(maxSize, lastValue: lastPaddingHeight) {
+                commands.paddingHeight = maxSize
+                lastPaddingHeight = maxSize
+                counters.paddingHeightWrites += 1
+            } else {
+                counters.skippedWrites += 1
+            }
+        }
+
+        return commands
+    }
+
+    /**
+     Changes the ratios of the ad, for instance once the actual ratio of the creative is known.
+
+     All heights will be emitted again on the next scroll event.
+
+     @param maxRatio The new maximum ratio of the ad.
+     @param minRatio The new minimum ratio of the ad before it is stuck.
+     */
+    mutating func updateRatios(maxRatio: CGFloat, minRatio: CGFloat) {
+        self.maxRatio = maxRatio
+        self.minRatio = minRatio
+        invalidateAppliedHeights()
+        needsStuckHeightUpdate = isStuck
+    }
+
+    /**
+     Invalidates the last emitted heights so they are all emitted again on the next scroll event.
+
+     This must be called if the constraints have been modified outside of the layout engine.
+     */
+    mutating func invalidateAppliedHeights() {
+        lastAdContainerHeight = nil
+        lastPaddingHeight = nil
+    }
+
+    /**
+     Returns whether a transition can be emitted at the given timestamp, depending on the minimum state duration.
+
+     A delayed transition is recorded as pending, with the timestamp from which it can be emitted.
+     */
+    private mutating func canTransition(_ transition: Transition, at timestamp: TimeInterval, commands: inout Commands) -> Bool {
+        // The comparison matches the pending timestamp exactly, so a scroll event replayed at this time always emits it.
+        guard let lastTransitionTimestamp, timestamp < lastTransitionTimestamp + minimumStateDuration else {
+            return true
+        }
+        counters.delayedTransitions += 1
+        pendingTransition = transition
+        commands.pendingTransitionTimestamp = lastTransitionTimestamp + minimumStateDuration
+        return false
+    }
+
+    /**
+     Records a transition emitted at the given timestamp.
+     */
+    private mutating func registerTransition(at timestamp: TimeInterval) {
+        lastTransitionTimestamp = timestamp
+        counters.transitions += 1
+    }
+
+    /**
+     Returns whether a height must be emitted, depending on the last value emitted for it and the change threshold.
+     */
+    private func shouldEmit(_ value: CGFloat, lastValue: CGFloat?) -> Bool {
+        guard let changeThreshold, let lastValue else { return true }
+        return abs(value - lastValue) > changeThreshold
+    }
+
+    /**
+     Marks the ad as closed: the layout will not emit any command after this call.
+     */
+    mutating func close() {
+        isClosed = true
+        pendingTransition = .none
+    }
+
+}
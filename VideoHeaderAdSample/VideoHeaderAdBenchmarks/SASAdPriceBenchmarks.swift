@@ -0,0 +1,121 @@
+//
+//  SASAdPriceBenchmarks.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import Foundation
+import XCTest
+@testable import VideoHeaderAdCore
+
+/**
+ Benchmark of the parsing and of the currency conversion of cleared prices, comparing `SASAdPrice` and
+ `SASAdPriceConverter` with the usual `Double(String)` and `Decimal(string:locale:)` parsers.
+ */
+final class SASAdPriceBenchmarks: XCTestCase {
+    
+    // MARK: - Constants
+    
+    #if DEBUG
+    private static let RECORD_COUNT = 100_000
+    #else
+    private static let RECORD_COUNT = 10_000_000
+    #endif
+    
+    /// Value of one unit of each currency in euros, in micro units.
+    private static let EXCHANGE_RATES: [(code: String, rate: Int64)] = [("USD", 921_384), ("GBP", 1_172_530), ("CHF", 1_047_610), ("JPY", 6_215), ("SEK", 87_452)]
+    
+    // MARK: - Properties
+    
+    private var converter = SASAdPriceConverter(reportingCurrency: .EUR)
+    private var strings = [String]()
+    private var currencies = [SASCurrency]()
+    
+    // MARK: - Setup
+    
+    override func setUp() {
+        super.setUp()
+        
+        var supportedCurrencies = [SASCurrency.EUR]
+        for (code, rate) in Self.EXCHANGE_RATES {
+            guard let currency = SASCurrency(code: code) else { continue }
+            converter.setExchangeRate(SASAdPrice(microUnits: rate), for: currency)
+            supportedCurrencies.append(currency)
+        }
+        
+        // Prices have up to 6 fraction digits and are grouped in runs of up to 256 records in the same currency,
+        // like records grouped by publisher. Generating the records is not measured.
+        var generator = SeededRandomNumberGenerator(seed: 0)
+        strings.reserveCapacity(Self.RECORD_COUNT)
+        currencies.reserveCapacity(Self.RECORD_COUNT)
+        while strings.count < Self.RECORD_COUNT {
+            let currency = supportedCurrencies.randomElement(using: &generator)!
+            for _ in 0..<min(Int.random(in: 1...256, using: &generator), Self.RECORD_COUNT - strings.count) {
+                let fractionDigits = Int.random(in: 0...SASAdPrice.FRACTION_DIGITS, using: &generator)
+                let fraction = String(Int.random(in: 0..<1_000_000, using: &generator) + 1_000_000).dropFirst().prefix(fractionDigits)
+                let integer = Int.random(in: 0..<50, using: &generator)
+                strings.append(fraction.isEmpty ? "\(integer)" : "\(integer).\(fraction)")
+                currencies.append(currency)
+            }
+        }
+    }
+    
+    // MARK: - Benchmarks
+    
+    func testParsing() {
+        var doubles = [Double?]()
+        doubles.reserveCapacity(strings.count)
+        let doubleParsing = SASBenchmark.measure(operationCount: strings.count) {
+            for string in strings {
+                doubles.append(Double(string))
+            }
+        }
+        SASBenchmark.report("price parsing, Double(String)", doubleParsing, unit: "record")
+        
+        let locale = Locale(identifier: "en_US_POSIX")
+        var decimals = [Decimal?]()
+        decimals.reserveCapacity(strings.count)
+        let decimalParsing = SASBenchmark.measure(operationCount: strings.count) {
+            for string in strings {
+                decimals.append(Decimal(string: string, locale: locale))
+            }
+        }
+        SASBenchmark.report("price parsing, Decimal(string:locale:)", decimalParsing, unit: "record")
+        
+        var prices = [SASAdPrice?]()
+        prices.reserveCapacity(strings.count)
+        let fixedPointParsing = SASBenchmark.measure(operationCount: strings.count) {
+            for string in strings {
+                prices.append(SASAdPrice(string))
+            }
+        }
+        SASBenchmark.report("price parsing, SASAdPrice", fixedPointParsing, unit: "record")
+        
+        // The fixed-point parser must be exact and must not allocate.
+        XCTAssertEqual(zip(prices, decimals).filter { $0?.decimalValue != $1 }.count, 0)
+        if let allocationsPerRecord = fixedPointParsing.allocationsPerOperation {
+            XCTAssertLessThan(allocationsPerRecord, 0.001)
+        }
+    }
+    
+    func testConversion() {
+        let records = zip(strings, currencies).map { SASAdPriceConverter.Record(price: SASAdPrice($0) ?? .zero, currency: $1) }
+        
+        var scalarPrices = [SASAdPrice?]()
+        let scalarConversion = SASBenchmark.measure(operationCount: records.count) {
+            scalarPrices = converter.convert(records, vectorized: false)
+        }
+        SASBenchmark.report("price conversion, scalar", scalarConversion, unit: "record")
+        
+        var vectorizedPrices = [SASAdPrice?]()
+        let vectorizedConversion = SASBenchmark.measure(operationCount: records.count) {
+            vectorizedPrices = converter.convert(records, vectorized: true)
+        }
+        SASBenchmark.report("price conversion, vectorized", vectorizedConversion, unit: "record")
+        
+        // Both paths must convert every record identically.
+        XCTAssertEqual(zip(scalarPrices, vectorizedPrices).filter { $0 != $1 }.count, 0)
+    }
+    
+}
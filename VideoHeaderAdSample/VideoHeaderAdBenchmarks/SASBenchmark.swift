@@ -0,0 +1,82 @@
+//
+//  SASBenchmark.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import Foundation
+import SASAllocationCounter
+
+/**
+ Measurement of a benchmark: the time and the heap allocations spent per operation.
+ */
+struct SASBenchmarkMeasurement {
+    
+    /// Number of operations performed by the benchmark.
+    let operationCount: Int
+    
+    /// Total duration of the benchmark (in nanoseconds).
+    let duration: UInt64
+    
+    /// Total number of heap allocations performed by the benchmark, or nil if they cannot be counted on this platform.
+    let allocationCount: UInt64?
+    
+    /// Average duration of an operation (in nanoseconds).
+    var nanosecondsPerOperation: Double {
+        return Double(duration) / Double(max(operationCount, 1))
+    }
+    
+    /// Average number of heap allocations per operation, or nil if they cannot be counted on this platform.
+    var allocationsPerOperation: Double? {
+        return allocationCount.map { Double($0) / Double(max(operationCount, 1)) }
+    }
+    
+}
+
+/**
+ Minimal benchmark harness, measuring a block with a monotonic clock and counting its heap allocations (on glibc).
+ 
+ Benchmarks are meant to be run in release mode:
+     
+     swift test -c release --filter VideoHeaderAdBenchmarks
+ */
+enum SASBenchmark {
+    
+    /**
+     Runs a block once and measures it.
+     
+     @param operationCount The number of operations performed by the block, used to compute the per-operation values.
+     @param body The block to measure.
+     @return The measurement of the block.
+     */
+    static func measure(operationCount: Int, _ body: () -> Void) -> SASBenchmarkMeasurement {
+        let allocationsBefore = sas_allocation_count()
+        let start = DispatchTime.now().uptimeNanoseconds
+        body()
+        let duration = DispatchTime.now().uptimeNanoseconds - start
+        let allocations = sas_allocation_count() - allocationsBefore
+        
+        return SASBenchmarkMeasurement(
+            operationCount: operationCount,
+            duration: duration,
+            allocationCount: sas_allocation_counting_supported() ? allocations : nil
+        )
+    }
+    
+    /**
+     Prints the result of a benchmark on a single line.
+     
+     @param name The name of the benchmark.
+     @param measurement The measurement of the benchmark.
+     @param unit The name of an operation ('event', 'record', …).
+     @param details Additional values describing the work done by the benchmark, if any.
+     */
+    static func report(_ name: String, _ measurement: SASBenchmarkMeasurement, unit: String, details: String = "") {
+        let time = String(format: "%.1f", measurement.nanosecondsPerOperation)
+        let allocations = measurement.allocationsPerOperation.map { String(format: "%.3f", $0) } ?? "n/a"
+        let suffix = details.isEmpty ? "" : " — \(details)"
+        print("[benchmark] \(name) (\(measurement.operationCount) \(unit)s): \(time) ns/\(unit), \(allocations) allocs/\(unit)\(suffix)")
+    }
+    
+}
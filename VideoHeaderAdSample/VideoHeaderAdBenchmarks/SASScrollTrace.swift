@@ -0,0 +1,85 @@
+//
+//  SASScrollTrace.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import Foundation
+@testable import VideoHeaderAdCore
+
+/**
+ Synthetic scroll trace replayed by the layout benchmarks: a sequence of vertical offsets sampled at 120 Hz.
+ 
+ The trace alternates the gestures which stress the header ad layout: flings going far past the stick threshold and
+ back, slow drags (with some jitter) around the stick threshold, and pull-to-refresh rubber-banding above the top of
+ the table view. It is generated from a fixed seed, so every run replays the same trace.
+ */
+struct SASScrollTrace {
+    
+    // MARK: - Constants
+    
+    /// Interval between two scroll events (in seconds).
+    static let EVENT_INTERVAL: TimeInterval = 1.0 / 120.0
+    
+    /// Number of scroll events of a gesture.
+    private static let GESTURE_LENGTH = 240
+    
+    // MARK: - Properties
+    
+    /// The vertical offsets of the table view, one per scroll event.
+    let offsets: [CGFloat]
+    
+    /// The timestamps of the scroll events (in seconds).
+    let timestamps: [TimeInterval]
+    
+    // MARK: - Initialization
+    
+    /**
+     Generates a new scroll trace.
+     
+     @param eventCount The number of scroll events of the trace.
+     @param threshold The offset at which the banner is stuck (maximum size minus minimum size of the ad).
+     @param seed The seed of the trace.
+     */
+    init(eventCount: Int, threshold: CGFloat, seed: UInt64 = 0) {
+        // The seeded generator makes the trace independent of the random generator of the platform.
+        var generator = SeededRandomNumberGenerator(seed: seed)
+        func random() -> Double {
+            return Double.random(in: 0.0..<1.0, using: &generator)
+        }
+        
+        var offsets = [CGFloat]()
+        var timestamps = [TimeInterval]()
+        offsets.reserveCapacity(eventCount)
+        timestamps.reserveCapacity(eventCount)
+        
+        var gesture = 0
+        while offsets.count < eventCount {
+            let length = min(SASScrollTrace.GESTURE_LENGTH, eventCount - offsets.count)
+            let flingDistance = 1_000.0 + 3_000.0 * random()
+            for step in 0..<length {
+                let progress = Double(step) / Double(SASScrollTrace.GESTURE_LENGTH)
+                let offset: Double
+                switch gesture % 3 {
+                case 0:
+                    // Fling down then back up, decelerating exponentially.
+                    offset = flingDistance * sin(progress * .pi) * (1.0 - exp(-6.0 * progress))
+                case 1:
+                    // Slow drag around the stick threshold, with finger jitter.
+                    offset = Double(threshold) + 12.0 * sin(progress * 6.0 * .pi) + 2.0 * (random() - 0.5)
+                default:
+                    // Pull-to-refresh rubber-banding above the top of the table view.
+                    offset = -80.0 * sin(progress * .pi) * exp(-2.0 * progress)
+                }
+                offsets.append(CGFloat(offset))
+                timestamps.append(TimeInterval(offsets.count) * SASScrollTrace.EVENT_INTERVAL)
+            }
+            gesture += 1
+        }
+        
+        self.offsets = offsets
+        self.timestamps = timestamps
+    }
+    
+}
@@ -0,0 +1,74 @@
+//
+//  SASVideoHeaderAdLayoutBenchmarks.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import Foundation
+import XCTest
+@testable import VideoHeaderAdCore
+
+/**
+ Replays a scroll trace of 10^6 events through the geometry engine of the video header ad and reports the time and
+ the heap allocations spent per scroll event.
+ */
+final class SASVideoHeaderAdLayoutBenchmarks: XCTestCase {
+    
+    // MARK: - Constants
+    
+    private static let EVENT_COUNT = 1_000_000
+    private static let WIDTH: CGFloat = 390.0
+    private static let MAX_RATIO: CGFloat = 16.0 / 9.0
+    private static let MIN_RATIO: CGFloat = 32.0 / 9.0
+    
+    // MARK: - Benchmarks
+    
+    func testScrollTraceWithDefaultConfiguration() {
+        replayScrollTrace(named: "scroll trace, change-only updates") { _ in }
+    }
+    
+    func testScrollTraceWithEveryUpdateEmitted() {
+        replayScrollTrace(named: "scroll trace, every update emitted") { layout in
+            layout.changeThreshold = nil
+        }
+    }
+    
+    func testScrollTraceWithHysteresisAndDwellTime() {
+        replayScrollTrace(named: "scroll trace, hysteresis and dwell time") { layout in
+            layout.hysteresis = 8.0
+            layout.minimumStateDuration = 0.15
+        }
+    }
+    
+    // MARK: - Private methods
+    
+    private func replayScrollTrace(named name: String, configure: (inout SASVideoHeaderAdLayout) -> Void) {
+        var layout = SASVideoHeaderAdLayout(maxRatio: Self.MAX_RATIO, minRatio: Self.MIN_RATIO)
+        configure(&layout)
+        
+        // The trace is generated before the measurement, so only the work of the layout engine is measured.
+        let threshold = layout.maxSize(width: Self.WIDTH) - layout.minSize(width: Self.WIDTH)
+        let trace = SASScrollTrace(eventCount: Self.EVENT_COUNT, threshold: threshold)
+        
+        var emittedHeights = 0
+        let measurement = SASBenchmark.measure(operationCount: Self.EVENT_COUNT) {
+            for index in 0..<trace.offsets.count {
+                let commands = layout.scrollViewDidScroll(width: Self.WIDTH, offset: trace.offsets[index], timestamp: trace.timestamps[index])
+                if commands.adContainerHeight != nil {
+                    emittedHeights += 1
+                }
+            }
+        }
+        
+        let counters = layout.counters
+        SASBenchmark.report(name, measurement, unit: "event", details: "\(counters.transitions) transitions, \(counters.constraintWrites) constraint writes, \(emittedHeights) ad container heights")
+        
+        // Processing a scroll event must never allocate.
+        XCTAssertEqual(counters.scrollEvents, Self.EVENT_COUNT)
+        if let allocationsPerEvent = measurement.allocationsPerOperation {
+            XCTAssertLessThan(allocationsPerEvent, 0.001)
+        }
+    }
+    
+}
@@ -0,0 +1,101 @@
+//
+//  SASAdAsyncLoadingBenchmarks.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import XCTest
+@testable import VideoHeaderAdSample
+
+/**
+ Benchmark of the overhead of the Swift concurrency bridge (`SASAdLoadContinuation`) on many concurrent ad calls.
+ */
+final class SASAdAsyncLoadingBenchmarks: XCTestCase {
+    
+    // MARK: - Constants
+    
+    private static let LOAD_COUNT = 10_000
+    
+    /// Short latencies, so the main actor is stressed by the resumptions rather than waiting for the responses.
+    private static let PROFILE = SASAdServerSimulator.Profile(latency: .uniform(0.001, 0.010))
+    
+    // MARK: - Benchmarks
+    
+    @MainActor
+    func testContinuationOverheadOfConcurrentLoads() async {
+        let completionDuration = await runCompletionLoads(server: SASAdServerSimulator(profile: Self.PROFILE))
+        
+        let start = DispatchTime.now().uptimeNanoseconds
+        let resumeDelays = await runAwaitedLoads(server: SASAdServerSimulator(profile: Self.PROFILE))
+        let continuationDuration = Self.seconds(since: start)
+        
+        let resumeDelay = SASAdLoadGenerator.Percentiles(resumeDelays)
+        print("[benchmark] continuation overhead (\(Self.LOAD_COUNT) concurrent loads): resume delay p50 \(Int(resumeDelay.p50 * 1_000_000.0)) µs, p99 \(Int(resumeDelay.p99 * 1_000_000.0)) µs — \(continuationDuration) s awaited vs \(completionDuration) s with completions")
+        
+        // Every awaiting task must be resumed with the result of its ad call.
+        XCTAssertEqual(resumeDelay.count, Self.LOAD_COUNT)
+    }
+    
+    // MARK: - Private methods
+    
+    /**
+     Runs the concurrent ad calls with plain completions delivered on the main queue (the baseline).
+     
+     @return The wall time (in seconds) until the last completion has been called.
+     */
+    @MainActor
+    private func runCompletionLoads(server: SASAdServerSimulator) async -> TimeInterval {
+        let start = DispatchTime.now().uptimeNanoseconds
+        await withCheckedContinuation { (allLoadsCompleted: CheckedContinuation<Void, Never>) in
+            var remainingLoads = Self.LOAD_COUNT
+            for _ in 0..<Self.LOAD_COUNT {
+                server.requestAd { _ in
+                    remainingLoads -= 1
+                    if remainingLoads == 0 {
+                        allLoadsCompleted.resume()
+                    }
+                }
+            }
+        }
+        return Self.seconds(since: start)
+    }
+    
+    /**
+     Runs the concurrent ad calls, each awaited by its own child task through a `SASAdLoadContinuation` (like
+     `SASAdLoadCoalescer.loadBannerViews(with:)` does).
+     
+     @return The delay between the delivery of each response on the main queue and the resumption of the task
+     awaiting it (in seconds), for the tasks resumed with a response.
+     */
+    @MainActor
+    private func runAwaitedLoads(server: SASAdServerSimulator) async -> [TimeInterval] {
+        return await withTaskGroup(of: TimeInterval?.self) { group in
+            for _ in 0..<Self.LOAD_COUNT {
+                group.addTask { @MainActor in
+                    let continuation = SASAdLoadContinuation<UInt64>()
+                    let deliveryTime = try? await continuation.perform({
+                        server.requestAd { _ in
+                            continuation.resume(with: .success(DispatchTime.now().uptimeNanoseconds))
+                        }
+                    }, cancellation: {})
+                    return deliveryTime.map(Self.seconds(since:))
+                }
+            }
+            
+            var resumeDelays = [TimeInterval]()
+            resumeDelays.reserveCapacity(Self.LOAD_COUNT)
+            for await resumeDelay in group {
+                if let resumeDelay {
+                    resumeDelays.append(resumeDelay)
+                }
+            }
+            return resumeDelays
+        }
+    }
+    
+    private static func seconds(since start: UInt64) -> TimeInterval {
+        return TimeInterval(DispatchTime.now().uptimeNanoseconds - start) / 1_000_000_000.0
+    }
+    
+}
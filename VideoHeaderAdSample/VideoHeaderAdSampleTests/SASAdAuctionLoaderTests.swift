@@ -0,0 +1,279 @@
+//
+//  SASAdAuctionLoaderTests.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import UIKit
+import XCTest
+import SASDisplayKit
+@testable import VideoHeaderAdSample
+
+/**
+ Tests of the auction loader, loading each placement from its own ad server simulator.
+ 
+ The simulated ads have no programmatic info: the price of each bid is the one of its bidder, read by the auction from
+ the loader. Latencies and deadlines are scaled down (a few milliseconds instead of a few hundred), so the auctions run
+ in real time quickly.
+ */
+final class SASAdAuctionLoaderTests: XCTestCase {
+    
+    // MARK: - Constants
+    
+    private static let PLACEMENT_COUNT = 10
+    
+    // MARK: - Tests
+    
+    func testBestPriceWins() {
+        let (auction, loader) = Self.makeAuction(bidders: [
+            SASAuctionBidder(price: "1.50"),
+            SASAuctionBidder(price: "2.25"),
+            SASAuctionBidder(price: nil),
+        ])
+        
+        let (result, report) = run(auction, loader: loader)
+        
+        XCTAssertEqual(try result.get().placementIndex, 1)
+        XCTAssertEqual(try result.get().price, SASAdPrice("2.25"))
+        XCTAssertEqual(report.bids, 3)
+        XCTAssertEqual(report.failures, 0)
+        XCTAssertEqual(report.cancellations, 0)
+    }
+    
+    func testPricesAreComparedInReferenceCurrency() {
+        let (auction, loader) = Self.makeAuction(bidders: [
+            SASAuctionBidder(price: "2.00"),
+            SASAuctionBidder(price: "2.10", currencyCode: "USD"),
+            SASAuctionBidder(price: "9.99", currencyCode: "GBP"),
+        ], exchangeRates: [.USD: SASAdPrice("0.9")!])
+        
+        let (result, _) = run(auction, loader: loader)
+        
+        // The USD bid is worth 1.89 EUR, and the GBP bid has no exchange rate: it is handled as an unpriced bid.
+        XCTAssertEqual(try result.get().placementIndex, 0)
+        XCTAssertEqual(auction.price(of: try result.get().adInfo), SASAdPrice("2.00"))
+    }
+    
+    func testTieIsWonByFirstPlacement() {
+        // The second placement returns first: the first one still wins the tie once it returns.
+        let (auction, loader) = Self.makeAuction(bidders: [
+            SASAuctionBidder(price: "1.00", latency: 0.03),
+            SASAuctionBidder(price: "1.00", latency: 0.01),
+        ])
+        
+        let (result, _) = run(auction, loader: loader)
+        
+        XCTAssertEqual(try result.get().placementIndex, 0)
+    }
+    
+    func testUnpricedBidOnlyWinsWithoutPricedBid() {
+        let (pricedAuction, pricedLoader) = Self.makeAuction(bidders: [
+            SASAuctionBidder(price: nil, latency: 0.01),
+            SASAuctionBidder(price: "0.01", latency: 0.03),
+        ])
+        let (unpricedAuction, unpricedLoader) = Self.makeAuction(bidders: [
+            SASAuctionBidder(price: nil, latency: 0.03),
+            SASAuctionBidder(price: nil, latency: 0.01),
+        ])
+        
+        let pricedWinner = try? run(pricedAuction, loader: pricedLoader).0.get()
+        let unpricedWinner = try? run(unpricedAuction, loader: unpricedLoader).0.get()
+        
+        XCTAssertEqual(pricedWinner?.placementIndex, 1)
+        XCTAssertEqual(unpricedWinner?.placementIndex, 0)
+        XCTAssertNotNil(unpricedWinner)
+        XCTAssertNil(unpricedWinner?.price)
+    }
+    
+    func testDeadlineCancelsAdCallsInFlight() {
+        // The best bidder is too slow: the auction is closed after 50 ms with the bid received so far.
+        let (auction, loader) = Self.makeAuction(bidders: [
+            SASAuctionBidder(price: "1.00", latency: 0.01),
+            SASAuctionBidder(price: "5.00", latency: 0.3),
+        ], deadline: 0.05)
+        
+        let (result, report) = run(auction, loader: loader)
+        
+        XCTAssertEqual(try result.get().placementIndex, 0)
+        XCTAssertEqual(report.bids, 1)
+        XCTAssertEqual(report.cancellations, 1)
+        XCTAssertGreaterThanOrEqual(report.latency, 0.05)
+        XCTAssertLessThan(report.latency, 0.3)
+        
+        // The cancelled ad call never returns.
+        wait(seconds: 0.4)
+        XCTAssertEqual(loader.deliveredAdCalls, 1)
+    }
+    
+    func testAuctionWithoutBidFails() {
+        let (slowAuction, slowLoader) = Self.makeAuction(bidders: [SASAuctionBidder(price: "1.00", latency: 0.3)], deadline: 0.05)
+        let (noFillAuction, noFillLoader) = Self.makeAuction(bidders: [SASAuctionBidder(price: "1.00", noFillRate: 1.0)])
+        let (emptyAuction, emptyLoader) = Self.makeAuction(bidders: [])
+        
+        XCTAssertEqual(Self.loadingError(of: run(slowAuction, loader: slowLoader).0), .deadlineExceeded)
+        XCTAssertEqual(Self.loadingError(of: run(noFillAuction, loader: noFillLoader).0), .noBid)
+        XCTAssertEqual(Self.loadingError(of: run(emptyAuction, loader: emptyLoader).0), .noPlacement)
+    }
+    
+    func testCancelledAuctionCancelsAdCalls() {
+        let (auction, loader) = Self.makeAuction(bidders: [SASAuctionBidder(price: "1.00"), SASAuctionBidder(price: "2.00")])
+        let notCompleted = expectation(description: "The cancelled auction is not completed")
+        notCompleted.isInverted = true
+        
+        let auctionLoader = SASAdAuctionLoader(auction: auction, loader: loader)
+        auctionLoader.load(modalParentViewController: nil) { _, _ in
+            notCompleted.fulfill()
+        }
+        auctionLoader.cancel()
+        
+        wait(for: [notCompleted], timeout: 0.1)
+        XCTAssertEqual(loader.deliveredAdCalls, 0)
+    }
+    
+    func testBeatenBidsAreReleased() {
+        // Each bid beats the previous one, so every bid but the last one is released as soon as it is beaten.
+        let bidders = (0..<Self.PLACEMENT_COUNT).map { index in
+            SASAuctionBidder(price: "\(index + 1).00", latency: 0.005 * Double(index + 1))
+        }
+        let (auction, loader) = Self.makeAuction(bidders: bidders)
+        
+        let (result, report) = run(auction, loader: loader)
+        let winner = try? result.get()
+        
+        XCTAssertEqual(winner?.placementIndex, Self.PLACEMENT_COUNT - 1)
+        XCTAssertEqual(loader.deliveredAdCalls, Self.PLACEMENT_COUNT)
+        XCTAssertEqual(loader.bannerViews.allObjects.count, 1)
+        XCTAssertTrue(loader.bannerViews.allObjects.first === winner?.bannerView)
+        XCTAssertGreaterThan(report.retainedBannersHighWaterMark, 0)
+        XCTAssertLessThanOrEqual(report.retainedBannersHighWaterMark, Self.PLACEMENT_COUNT + 1)
+    }
+    
+    func testReportMeasuresLatencyAndMemory() {
+        let bidders = (0..<Self.PLACEMENT_COUNT).map { index in
+            SASAuctionBidder(price: "1.\(index)", latency: 0.02)
+        }
+        let (auction, loader) = Self.makeAuction(bidders: bidders)
+        
+        let (_, report) = run(auction, loader: loader)
+        
+        print("[benchmark] auction (\(Self.PLACEMENT_COUNT) placements): latency \(Int(report.latency * 1_000.0)) ms, \(report.retainedBannersHighWaterMark) banners retained at most, memory high-water mark \(report.memoryHighWaterMark / 1_048_576) MB")
+        
+        // The auction ends with the last bid, without waiting for its deadline.
+        XCTAssertGreaterThanOrEqual(report.latency, 0.02)
+        XCTAssertLessThan(report.latency, auction.deadline)
+        XCTAssertEqual(report.bids, Self.PLACEMENT_COUNT)
+        XCTAssertGreaterThan(report.memoryHighWaterMark, 0)
+    }
+    
+    // MARK: - Private methods
+    
+    /**
+     Returns an auction of a placement per bidder, and the loader routing each placement to its bidder.
+     
+     @param bidders The bidders, in the order of their placements.
+     @param deadline The deadline of the auction.
+     @param exchangeRates The exchange rates of the currencies of the bids to euros.
+     @return The auction, reading the prices of the bidders, and its loader.
+     */
+    private static func makeAuction(bidders: [SASAuctionBidder], deadline: TimeInterval = 1.0, exchangeRates: [SASCurrency: SASAdPrice] = [:]) -> (SASAdAuction, SASAuctionBidLoader) {
+        let adPlacements = bidders.indices.map { index in
+            SASAdPlacement(siteId: 507206, pageId: 1579908, formatId: 15048, keywordTargeting: "bidder\(index)")
+        }
+        let loader = SASAuctionBidLoader(bidders: Dictionary(uniqueKeysWithValues: zip(adPlacements.map(\.placementKey), bidders)))
+        
+        var auction = SASAdAuction(adPlacements: adPlacements, deadline: deadline)
+        auction.priceConverter = SASAdPriceConverter(reportingCurrency: .EUR, exchangeRates: exchangeRates)
+        auction.clearedPrice = { [unowned loader] adInfo in loader.clearedPrice(of: adInfo) }
+        return (auction, loader)
+    }
+    
+    private func run(_ auction: SASAdAuction, loader: SASAuctionBidLoader) -> (Result<SASAdAuctionLoader.Winner, any Error>, SASAdAuctionLoader.Report) {
+        let completed = expectation(description: "The auction is completed")
+        var auctionResult: (Result<SASAdAuctionLoader.Winner, any Error>, SASAdAuctionLoader.Report)?
+        
+        let auctionLoader = SASAdAuctionLoader(auction: auction, loader: loader)
+        auctionLoader.load(modalParentViewController: nil) { result, report in
+            auctionResult = (result, report)
+            completed.fulfill()
+        }
+        
+        wait(for: [completed], timeout: 2.0)
+        return auctionResult ?? (.failure(CancellationError()), SASAdAuctionLoader.Report())
+    }
+    
+    private static func loadingError(of result: Result<SASAdAuctionLoader.Winner, any Error>) -> SASAdAuction.LoadingError? {
+        guard case .failure(let error) = result else { return nil }
+        return error as? SASAdAuction.LoadingError
+    }
+    
+    private func wait(seconds: TimeInterval) {
+        let elapsed = expectation(description: "The delay has elapsed")
+        DispatchQueue.main.asyncAfter(deadline: .now() + seconds) {
+            elapsed.fulfill()
+        }
+        wait(for: [elapsed], timeout: seconds + 1.0)
+    }
+    
+}
+
+/**
+ Bidder of an auction: the ad server simulator of its placement, and the price of its ads.
+ */
+private struct SASAuctionBidder {
+    
+    let server: SASAdServerSimulator
+    let price: String?
+    let currencyCode: String?
+    
+    init(price: String?, currencyCode: String? = nil, latency: TimeInterval = 0.01, noFillRate: Double = 0.0) {
+        self.server = SASAdServerSimulator(profile: SASAdServerSimulator.Profile(latency: .constant(latency), noFillRate: noFillRate))
+        self.price = price
+        self.currencyCode = currencyCode
+    }
+    
+}
+
+/**
+ Loader routing each placement to its bidder, recording the price of each delivered ad and keeping a weak reference on
+ each delivered banner view.
+ */
+private final class SASAuctionBidLoader: SASAdLoader {
+    
+    /// The banner views delivered to the auction and still retained.
+    let bannerViews = NSHashTable<SASBannerView>.weakObjects()
+    
+    /// Number of ad calls which have returned to the auction.
+    private(set) var deliveredAdCalls = 0
+    
+    private let bidders: [SASAdPlacementKey: SASAuctionBidder]
+    private var clearedPrices = [ObjectIdentifier: (price: String, currencyCode: String?)]()
+    
+    init(bidders: [SASAdPlacementKey: SASAuctionBidder]) {
+        self.bidders = bidders
+    }
+    
+    func clearedPrice(of adInfo: SASAdInfo) -> (price: String, currencyCode: String?)? {
+        return clearedPrices[ObjectIdentifier(adInfo)]
+    }
+    
+    func loadBannerView(with adPlacement: SASAdPlacement, completion: @escaping BannerCompletion) -> SASAdCall {
+        let bidder = bidders[adPlacement.placementKey]!
+        return bidder.server.loadBannerView(with: adPlacement) { [weak self] result in
+            if let self {
+                self.deliveredAdCalls += 1
+                if case .success(let loadedAd) = result {
+                    // The entry is always replaced, since the identifier of a released ad info can be reused.
+                    self.clearedPrices[ObjectIdentifier(loadedAd.adInfo)] = bidder.price.map { ($0, bidder.currencyCode) }
+                    self.bannerViews.add(loadedAd.bannerView)
+                }
+            }
+            completion(result)
+        }
+    }
+    
+    func loadInterstitial(with adPlacement: SASAdPlacement, completion: @escaping InterstitialCompletion) -> SASAdCall {
+        return bidders[adPlacement.placementKey]!.server.loadInterstitial(with: adPlacement, completion: completion)
+    }
+    
+}
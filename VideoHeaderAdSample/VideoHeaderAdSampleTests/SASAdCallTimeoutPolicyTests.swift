@@ -0,0 +1,100 @@
+//
+//  SASAdCallTimeoutPolicyTests.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import XCTest
+import SASDisplayKit
+@testable import VideoHeaderAdSample
+
+/**
+ Tests of the adaptive ad call timeout, enforced by the coalescer on ad calls performed by the ad server simulator.
+ 
+ Latencies are scaled down (a few milliseconds instead of a few hundred), so the loads run in real time quickly.
+ */
+final class SASAdCallTimeoutPolicyTests: XCTestCase {
+    
+    // MARK: - Constants
+    
+    private static let AD_PLACEMENT = SASAdPlacement(siteId: 507206, pageId: 1579908, formatId: 15048, keywordTargeting: "timeout")
+    
+    /// Number of loads observed before the timeout is adapted.
+    private static let WARM_UP_COUNT = 20
+    
+    /// Number of loads measured once the timeout has been adapted.
+    private static let LOAD_COUNT = 100
+    
+    /// Fast ad calls, 10% of them having a slow body which takes 10 to 20 times longer.
+    private static let PROFILE = SASAdServerSimulator.Profile(
+        latency: .logNormal(median: 0.010, sigma: 0.5),
+        slowBodyRate: 0.1,
+        slowBodyLatency: .uniform(0.1, 0.2)
+    )
+    
+    /// Timeout of twice the 80th latency percentile, so the slow bodies are cut.
+    private static let CONFIGURATION = SASAdCallTimeoutPolicy.Configuration(
+        percentile: 80.0,
+        multiplier: 2.0,
+        floor: 0.02,
+        ceiling: 1.0,
+        minimumSampleCount: SASAdCallTimeoutPolicyTests.WARM_UP_COUNT,
+        windowSampleCount: 200
+    )
+    
+    // MARK: - Tests
+    
+    func testAdaptedTimeoutTradesFillRateForTimeToDisplay() {
+        let globalTimeout = run(timeoutPolicy: nil)
+        
+        let timeoutPolicy = SASAdCallTimeoutPolicy()
+        timeoutPolicy.setConfiguration(Self.CONFIGURATION, for: Self.AD_PLACEMENT)
+        let adaptedTimeout = run(timeoutPolicy: timeoutPolicy)
+        
+        let global = SASAdLoadSequence.Summary(globalTimeout.dropFirst(Self.WARM_UP_COUNT))
+        let adapted = SASAdLoadSequence.Summary(adaptedTimeout.dropFirst(Self.WARM_UP_COUNT))
+        print("[benchmark] adapted timeout (\(Self.LOAD_COUNT) loads): fill rate \(adapted.fillRate) vs \(global.fillRate), time to outcome p99 \(Int(adapted.timeToOutcome.p99 * 1_000.0)) ms vs \(Int(global.timeToOutcome.p99 * 1_000.0)) ms, time to display p50 \(Int(adapted.timeToDisplay.p50 * 1_000.0)) ms vs \(Int(global.timeToDisplay.p50 * 1_000.0)) ms")
+        
+        // The timeout has been adapted after the warm-up, well below the global timeout.
+        let timeout = timeoutPolicy.timeout(for: Self.AD_PLACEMENT)
+        XCTAssertLessThan(timeout, 0.1)
+        XCTAssertLessThan(timeout, SASConfiguration.shared.adCallTimeout)
+        
+        // Only the slow ad calls are cut: about 10% of fill rate is traded for a much shorter tail.
+        XCTAssertEqual(global.fillRate, 1.0)
+        XCTAssertLessThan(adapted.fillRate, global.fillRate)
+        XCTAssertGreaterThan(adapted.fillRate, 0.75)
+        XCTAssertLessThan(adapted.timeToOutcome.p99, global.timeToOutcome.p99 / 2.0)
+        
+        // The loads cut by the coalescer fail with the adapted timeout, the SDK timeout being far longer.
+        let errors = adaptedTimeout.dropFirst(Self.WARM_UP_COUNT).compactMap(\.error)
+        XCTAssertFalse(errors.isEmpty)
+        XCTAssertTrue(errors.allSatisfy { $0 is SASAdCallTimeoutError })
+    }
+    
+    func testTimeoutIsNotAdaptedBeforeEnoughAdCalls() {
+        let timeoutPolicy = SASAdCallTimeoutPolicy()
+        timeoutPolicy.setConfiguration(Self.CONFIGURATION, for: Self.AD_PLACEMENT)
+        let coalescer = SASAdLoadCoalescer(loader: SASAdServerSimulator(profile: Self.PROFILE))
+        coalescer.timeoutPolicy = timeoutPolicy
+        
+        let loads = SASAdLoadSequence(coalescer: coalescer, adPlacement: Self.AD_PLACEMENT).run(count: Self.WARM_UP_COUNT - 1, in: self, timeout: 10.0)
+        
+        // The slow bodies are not cut during the warm-up.
+        XCTAssertTrue(loads.allSatisfy(\.succeeded))
+        XCTAssertEqual(timeoutPolicy.timeout(for: Self.AD_PLACEMENT), SASConfiguration.shared.adCallTimeout)
+    }
+    
+    // MARK: - Private methods
+    
+    private func run(timeoutPolicy: SASAdCallTimeoutPolicy?) -> [SASAdLoadSequence.Load] {
+        // Both runs draw the same ad calls from the same seed.
+        let coalescer = SASAdLoadCoalescer(loader: SASAdServerSimulator(profile: Self.PROFILE, seed: 7))
+        coalescer.timeoutPolicy = timeoutPolicy
+        
+        let sequence = SASAdLoadSequence(coalescer: coalescer, adPlacement: Self.AD_PLACEMENT)
+        return sequence.run(count: Self.WARM_UP_COUNT + Self.LOAD_COUNT, in: self, timeout: 60.0)
+    }
+    
+}
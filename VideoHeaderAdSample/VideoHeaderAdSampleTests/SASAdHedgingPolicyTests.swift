@@ -0,0 +1,106 @@
+//
+//  SASAdHedgingPolicyTests.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import XCTest
+import SASDisplayKit
+@testable import VideoHeaderAdSample
+
+/**
+ Tests of the hedging of slow ad calls by the coalescer, against an ad server simulator with a heavy-tailed latency.
+ 
+ Latencies are scaled down (a few milliseconds instead of a few hundred), so the loads run in real time quickly.
+ */
+final class SASAdHedgingPolicyTests: XCTestCase {
+    
+    // MARK: - Constants
+    
+    private static let AD_PLACEMENT = SASAdPlacement(siteId: 507206, pageId: 1579908, formatId: 15048, keywordTargeting: "hedging")
+    
+    /// Number of loads observed before the ad calls are hedged.
+    private static let WARM_UP_COUNT = 20
+    
+    /// Number of loads measured once the ad calls can be hedged.
+    private static let LOAD_COUNT = 300
+    
+    /// Heavy-tailed latency: a median of 8 ms, but 1% of the ad calls last more than 100 ms.
+    private static let PROFILE = SASAdServerSimulator.Profile(latency: .pareto(minimum: 0.005, shape: 1.5))
+    
+    /// Hedge after the 90th latency percentile, with at most 10% extra ad calls.
+    private static let CONFIGURATION = SASAdHedgingPolicy.Configuration(
+        percentile: 90.0,
+        minimumDelay: 0.0,
+        minimumSampleCount: SASAdHedgingPolicyTests.WARM_UP_COUNT,
+        budgetRatio: 0.1,
+        maximumBurst: 5.0
+    )
+    
+    // MARK: - Tests
+    
+    func testHedgingCutsTailLatencyWithinBudget() {
+        let unhedgedServer = SASAdServerSimulator(profile: Self.PROFILE)
+        let unhedged = run(server: unhedgedServer, hedgingPolicy: nil)
+        
+        let hedgedServer = SASAdServerSimulator(profile: Self.PROFILE)
+        let hedgingPolicy = SASAdHedgingPolicy(configuration: Self.CONFIGURATION)
+        let hedged = run(server: hedgedServer, hedgingPolicy: hedgingPolicy)
+        
+        let unhedgedSummary = SASAdLoadSequence.Summary(unhedged.dropFirst(Self.WARM_UP_COUNT))
+        let hedgedSummary = SASAdLoadSequence.Summary(hedged.dropFirst(Self.WARM_UP_COUNT))
+        let counters = hedgingPolicy.counters
+        print("[benchmark] hedging (\(Self.LOAD_COUNT) loads): time to display p50 \(Int(hedgedSummary.timeToDisplay.p50 * 1_000.0)) ms vs \(Int(unhedgedSummary.timeToDisplay.p50 * 1_000.0)) ms, p99 \(Int(hedgedSummary.timeToDisplay.p99 * 1_000.0)) ms vs \(Int(unhedgedSummary.timeToDisplay.p99 * 1_000.0)) ms — \(counters.hedges) hedges (\(counters.wins) wins, \(counters.budgetDenials) denied by the budget)")
+        
+        // Every load is delivered once, and the hedges cut the tail.
+        XCTAssertEqual(hedged.count, Self.WARM_UP_COUNT + Self.LOAD_COUNT)
+        XCTAssertEqual(hedgedSummary.fillRate, 1.0)
+        XCTAssertGreaterThan(counters.wins, 0)
+        XCTAssertLessThan(hedgedSummary.timeToDisplay.p99, unhedgedSummary.timeToDisplay.p99)
+        
+        // Each hedge performs exactly one extra ad call, within the budget.
+        XCTAssertEqual(unhedgedServer.adCallCount, unhedged.count)
+        XCTAssertEqual(hedgedServer.adCallCount, hedged.count + counters.hedges)
+        XCTAssertLessThanOrEqual(Double(counters.hedges), Self.CONFIGURATION.maximumBurst + Self.CONFIGURATION.budgetRatio * Double(hedged.count))
+    }
+    
+    func testExhaustedBudgetDeniesHedges() {
+        var configuration = Self.CONFIGURATION
+        configuration.budgetRatio = 0.0
+        configuration.maximumBurst = 2.0
+        let server = SASAdServerSimulator(profile: Self.PROFILE)
+        let hedgingPolicy = SASAdHedgingPolicy(configuration: configuration)
+        
+        let loads = run(server: server, hedgingPolicy: hedgingPolicy)
+        
+        // Only the initial budget is spent, the other slow ad calls are not hedged.
+        XCTAssertTrue(loads.allSatisfy(\.succeeded))
+        XCTAssertEqual(hedgingPolicy.counters.hedges, 2)
+        XCTAssertGreaterThan(hedgingPolicy.counters.budgetDenials, 0)
+        XCTAssertEqual(server.adCallCount, loads.count + 2)
+    }
+    
+    func testAdCallsAreNotHedgedBeforeEnoughAdCalls() {
+        let server = SASAdServerSimulator(profile: Self.PROFILE)
+        let hedgingPolicy = SASAdHedgingPolicy(configuration: Self.CONFIGURATION)
+        let coalescer = SASAdLoadCoalescer(loader: server)
+        coalescer.hedgingPolicy = hedgingPolicy
+        
+        let loads = SASAdLoadSequence(coalescer: coalescer, adPlacement: Self.AD_PLACEMENT).run(count: Self.WARM_UP_COUNT, in: self, timeout: 30.0)
+        
+        XCTAssertEqual(hedgingPolicy.counters, SASAdHedgingPolicy.Counters())
+        XCTAssertEqual(server.adCallCount, loads.count)
+    }
+    
+    // MARK: - Private methods
+    
+    private func run(server: SASAdServerSimulator, hedgingPolicy: SASAdHedgingPolicy?) -> [SASAdLoadSequence.Load] {
+        let coalescer = SASAdLoadCoalescer(loader: server)
+        coalescer.hedgingPolicy = hedgingPolicy
+        
+        let sequence = SASAdLoadSequence(coalescer: coalescer, adPlacement: Self.AD_PLACEMENT)
+        return sequence.run(count: Self.WARM_UP_COUNT + Self.LOAD_COUNT, in: self, timeout: 60.0)
+    }
+    
+}
@@ -0,0 +1,184 @@
+//
+//  SASAdLifecycleTracerTests.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import XCTest
+@testable import VideoHeaderAdSample
+
+/**
+ Tests of the latency histogram (buckets and percentiles) and of the aggregation of the traces by the lifecycle tracer.
+ */
+final class SASAdLifecycleTracerTests: XCTestCase {
+    
+    // MARK: - Constants
+    
+    private static let PLACEMENT = "507206/1579908/15048"
+    
+    // MARK: - Histogram tests
+    
+    func testSmallLatenciesAreExact() {
+        // The latencies below 256 µs have their own bucket.
+        var histogram = SASLatencyHistogram()
+        for latency in 1...200 as ClosedRange<UInt64> {
+            histogram.record(microseconds: latency)
+        }
+        
+        XCTAssertEqual(histogram.value(atPercentile: 0.0), 1)
+        XCTAssertEqual(histogram.value(atPercentile: 50.0), 100)
+        XCTAssertEqual(histogram.value(atPercentile: 99.0), 198)
+        XCTAssertEqual(histogram.value(atPercentile: 100.0), 200)
+    }
+    
+    func testPercentilesHaveTwoSignificantDigits() {
+        var histogram = SASLatencyHistogram()
+        for latency in 1...1_000 as ClosedRange<UInt64> {
+            histogram.record(microseconds: latency)
+        }
+        
+        // A percentile is the highest latency of its bucket: 500 and 501 µs share a bucket, 988 to 991 µs too.
+        XCTAssertEqual(histogram.value(atPercentile: 50.0), 501)
+        XCTAssertEqual(histogram.value(atPercentile: 99.0), 991)
+        XCTAssertEqual(histogram.value(atPercentile: 100.0), 1_000)
+        XCTAssertEqual(histogram.count, 1_000)
+        XCTAssertEqual(histogram.min, 1)
+        XCTAssertEqual(histogram.max, 1_000)
+        XCTAssertEqual(histogram.mean, 500.5)
+        
+        // Higher latencies keep a relative precision better than 1%.
+        for latency in [1_000, 12_345, 250_000, 3_000_000, 60_000_000] as [UInt64] {
+            var histogram = SASLatencyHistogram()
+            histogram.record(microseconds: latency)
+            histogram.record(microseconds: latency * 10)
+            
+            let value = histogram.value(atPercentile: 50.0)
+            XCTAssertGreaterThanOrEqual(value, latency)
+            XCTAssertLessThan(Double(value - latency), Double(latency) * 0.01)
+        }
+    }
+    
+    func testLatenciesAreClampedToHighestTrackableValue() {
+        var histogram = SASLatencyHistogram()
+        histogram.record(microseconds: .max)
+        
+        XCTAssertEqual(histogram.max, SASLatencyHistogram.HIGHEST_TRACKABLE_VALUE)
+        XCTAssertEqual(histogram.value(atPercentile: 50.0), SASLatencyHistogram.HIGHEST_TRACKABLE_VALUE)
+    }
+    
+    func testEmptyHistogramReturnsZero() {
+        let histogram = SASLatencyHistogram()
+        
+        XCTAssertEqual(histogram.value(atPercentile: 50.0), 0)
+        XCTAssertEqual(histogram.mean, 0.0)
+    }
+    
+    func testMergedHistogramsMatchSingleHistogram() {
+        var histogram = SASLatencyHistogram()
+        var lowHistogram = SASLatencyHistogram()
+        var highHistogram = SASLatencyHistogram()
+        for latency in stride(from: 10, through: 100_000, by: 10) as StrideThrough<UInt64> {
+            histogram.record(microseconds: latency)
+            if latency < 50_000 {
+                lowHistogram.record(microseconds: latency)
+            } else {
+                highHistogram.record(microseconds: latency)
+            }
+        }
+        
+        highHistogram.merge(lowHistogram)
+        
+        XCTAssertEqual(highHistogram, histogram)
+    }
+    
+    // MARK: - Tracer tests
+    
+    func testPhasesAreAggregatedByPlacement() {
+        let tracer = SASAdLifecycleTracer()
+        
+        let trace = tracer.beginTrace(placement: Self.PLACEMENT)
+        tracer.record(.didLoad, trace: trace)
+        tracer.record(.didLoad, trace: trace)
+        tracer.record(.close, trace: trace)
+        tracer.record(.click, trace: trace)
+        tracer.record(.didFailToLoad, trace: tracer.beginTrace(placement: "other"))
+        
+        // Only the first occurrence of a phase is counted, and nothing is recorded once the trace has ended.
+        let snapshot = tracer.snapshot()
+        XCTAssertEqual(snapshot.placements[Self.PLACEMENT]?[.didLoad]?.count, 1)
+        XCTAssertEqual(snapshot.placements[Self.PLACEMENT]?[.close]?.count, 1)
+        XCTAssertNil(snapshot.placements[Self.PLACEMENT]?[.click])
+        XCTAssertNil(snapshot.placements[Self.PLACEMENT]?[.loadAd])
+        XCTAssertEqual(snapshot.placements["other"]?[.didFailToLoad]?.count, 1)
+    }
+    
+    func testLatenciesAreMeasuredFromLoadAd() {
+        let tracer = SASAdLifecycleTracer()
+        
+        let trace = tracer.beginTrace(placement: Self.PLACEMENT)
+        Thread.sleep(forTimeInterval: 0.01)
+        tracer.record(.didLoad, trace: trace)
+        
+        let histogram = tracer.histogram(for: .didLoad, placement: Self.PLACEMENT)
+        XCTAssertGreaterThanOrEqual(histogram?.min ?? 0, 10_000)
+        XCTAssertLessThan(histogram?.max ?? .max, 1_000_000)
+    }
+    
+    func testEventsOfSeveralThreadsAreAggregated() {
+        let tracer = SASAdLifecycleTracer()
+        
+        DispatchQueue.concurrentPerform(iterations: 100) { _ in
+            let trace = tracer.beginTrace(placement: Self.PLACEMENT)
+            tracer.record(.didLoad, trace: trace)
+        }
+        
+        // A trace can end on another thread than the one which has started it.
+        let trace = tracer.beginTrace(placement: Self.PLACEMENT)
+        let closed = expectation(description: "The trace has been closed")
+        Thread {
+            tracer.record(.close, trace: trace)
+            closed.fulfill()
+        }.start()
+        wait(for: [closed], timeout: 1.0)
+        
+        XCTAssertEqual(tracer.histogram(for: .didLoad, placement: Self.PLACEMENT)?.count, 100)
+        XCTAssertEqual(tracer.histogram(for: .close, placement: Self.PLACEMENT)?.count, 1)
+    }
+    
+    func testFullBufferDropsTraceWithItsEvent() {
+        let tracer = SASAdLifecycleTracer()
+        for _ in 0..<SASAdLifecycleTracer.THREAD_BUFFER_CAPACITY {
+            XCTAssertNotNil(tracer.beginTrace(placement: Self.PLACEMENT))
+        }
+        
+        let droppedTrace = tracer.beginTrace(placement: Self.PLACEMENT)
+        tracer.record(.close, trace: droppedTrace)
+        
+        // The dropped trace is not opened: only the traces of the full buffer exceed the open trace limit.
+        let snapshot = tracer.snapshot()
+        XCTAssertNil(droppedTrace)
+        XCTAssertEqual(snapshot.droppedEvents, 1)
+        XCTAssertEqual(snapshot.discardedTraces, SASAdLifecycleTracer.THREAD_BUFFER_CAPACITY - SASAdLifecycleTracer.MAX_OPEN_TRACES)
+        XCTAssertNil(snapshot.placements[Self.PLACEMENT])
+    }
+    
+    func testEventsOfResetTraceAreSkipped() {
+        let tracer = SASAdLifecycleTracer()
+        let trace = tracer.beginTrace(placement: Self.PLACEMENT)
+        tracer.reset()
+        
+        tracer.record(.didLoad, trace: trace)
+        
+        XCTAssertNil(tracer.histogram(for: .didLoad, placement: Self.PLACEMENT))
+    }
+    
+    func testDisabledTracerRecordsNothing() {
+        let tracer = SASAdLifecycleTracer()
+        tracer.isEnabled = false
+        
+        XCTAssertNil(tracer.beginTrace(placement: Self.PLACEMENT))
+        XCTAssertTrue(tracer.snapshot().placements.isEmpty)
+    }
+    
+}
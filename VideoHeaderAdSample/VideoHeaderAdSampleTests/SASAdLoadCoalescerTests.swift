@@ -0,0 +1,160 @@
+//
+//  SASAdLoadCoalescerTests.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import XCTest
+import SASDisplayKit
+@testable import VideoHeaderAdSample
+
+/**
+ Tests of the coalescing of identical loads, performed against the ad server simulator.
+ */
+final class SASAdLoadCoalescerTests: XCTestCase {
+    
+    // MARK: - Constants
+    
+    private static let AD_PLACEMENT = SASAdPlacement(siteId: 507206, pageId: 1579908, formatId: 15048, keywordTargeting: "coalescer")
+    private static let OTHER_AD_PLACEMENT = SASAdPlacement(siteId: 507206, pageId: 1579908, formatId: 15048, keywordTargeting: "other")
+    
+    /// Number of concurrent loads of the same placement.
+    private static let LOAD_COUNT = 100
+    
+    private static let PROFILE = SASAdServerSimulator.Profile(latency: .constant(0.02))
+    
+    // MARK: - Tests
+    
+    func testConcurrentBannerLoadsPerformOneAdCall() {
+        let server = SASAdServerSimulator(profile: Self.PROFILE)
+        let coalescer = SASAdLoadCoalescer(loader: server)
+        let loaded = expectation(description: "Every load has returned")
+        loaded.expectedFulfillmentCount = Self.LOAD_COUNT
+        
+        var ads = [SASCoalescedAd<SASBannerView>]()
+        for _ in 0..<Self.LOAD_COUNT {
+            coalescer.loadBannerView(with: Self.AD_PLACEMENT) { result in
+                if let ad = try? result.get() {
+                    ads.append(ad)
+                }
+                loaded.fulfill()
+            }
+        }
+        wait(for: [loaded], timeout: 1.0)
+        
+        // Exactly one ad call, whose ad is delivered to every waiter and can only be claimed once.
+        XCTAssertEqual(server.adCallCount, 1)
+        XCTAssertEqual(coalescer.counters, SASAdLoadCoalescer.Counters(adCalls: 1, coalescedLoads: Self.LOAD_COUNT - 1))
+        XCTAssertEqual(ads.count, Self.LOAD_COUNT)
+        XCTAssertTrue(ads.allSatisfy { $0 === ads[0] })
+        XCTAssertEqual(ads.filter { $0.claim() }.count, 1)
+    }
+    
+    func testConcurrentInterstitialLoadsPerformOneAdCall() {
+        let server = SASAdServerSimulator(profile: Self.PROFILE)
+        let coalescer = SASAdLoadCoalescer(loader: server)
+        let loaded = expectation(description: "Every load has returned")
+        loaded.expectedFulfillmentCount = Self.LOAD_COUNT
+        
+        for _ in 0..<Self.LOAD_COUNT {
+            coalescer.loadInterstitial(with: Self.AD_PLACEMENT) { result in
+                XCTAssertNotNil(try? result.get())
+                loaded.fulfill()
+            }
+        }
+        wait(for: [loaded], timeout: 1.0)
+        
+        XCTAssertEqual(server.adCallCount, 1)
+        XCTAssertEqual(coalescer.counters.adCalls, 1)
+    }
+    
+    func testDifferentPlacementsAndKindsAreNotCoalesced() {
+        let server = SASAdServerSimulator(profile: Self.PROFILE)
+        let coalescer = SASAdLoadCoalescer(loader: server)
+        let loaded = expectation(description: "Every load has returned")
+        loaded.expectedFulfillmentCount = 3
+        
+        coalescer.loadBannerView(with: Self.AD_PLACEMENT) { _ in loaded.fulfill() }
+        coalescer.loadBannerView(with: Self.OTHER_AD_PLACEMENT) { _ in loaded.fulfill() }
+        coalescer.loadInterstitial(with: Self.AD_PLACEMENT) { _ in loaded.fulfill() }
+        wait(for: [loaded], timeout: 1.0)
+        
+        XCTAssertEqual(server.adCallCount, 3)
+        XCTAssertEqual(coalescer.counters, SASAdLoadCoalescer.Counters(adCalls: 3))
+    }
+    
+    func testFailureIsFannedOutToEveryWaiter() {
+        let server = SASAdServerSimulator(profile: SASAdServerSimulator.Profile(latency: .constant(0.02), noFillRate: 1.0))
+        let coalescer = SASAdLoadCoalescer(loader: server)
+        let failed = expectation(description: "Every load has failed")
+        failed.expectedFulfillmentCount = Self.LOAD_COUNT
+        
+        for _ in 0..<Self.LOAD_COUNT {
+            coalescer.loadBannerView(with: Self.AD_PLACEMENT) { result in
+                if case .failure(let error) = result {
+                    XCTAssertEqual((error as NSError).code, SASAdServerSimulator.NO_FILL_ERROR_CODE)
+                    failed.fulfill()
+                }
+            }
+        }
+        wait(for: [failed], timeout: 1.0)
+        
+        XCTAssertEqual(server.adCallCount, 1)
+    }
+    
+    func testCancelledWaitersDoNotAbandonTheSharedLoad() {
+        let server = SASAdServerSimulator(profile: Self.PROFILE)
+        let coalescer = SASAdLoadCoalescer(loader: server)
+        let loaded = expectation(description: "The remaining waiter is delivered")
+        
+        let cancelledRequests = (0..<Self.LOAD_COUNT - 1).map { _ in
+            coalescer.loadBannerView(with: Self.AD_PLACEMENT) { _ in
+                XCTFail("A cancelled load must not be delivered")
+            }
+        }
+        coalescer.loadBannerView(with: Self.AD_PLACEMENT) { result in
+            XCTAssertNotNil(try? result.get())
+            loaded.fulfill()
+        }
+        cancelledRequests.forEach { $0.cancel() }
+        wait(for: [loaded], timeout: 1.0)
+        
+        XCTAssertEqual(server.adCallCount, 1)
+        XCTAssertEqual(coalescer.counters.abandonedLoads, 0)
+    }
+    
+    func testLoadIsAbandonedOnceEveryWaiterIsCancelled() {
+        let server = SASAdServerSimulator(profile: Self.PROFILE)
+        let coalescer = SASAdLoadCoalescer(loader: server)
+        
+        let requests = (0..<Self.LOAD_COUNT).map { _ in
+            coalescer.loadBannerView(with: Self.AD_PLACEMENT) { _ in
+                XCTFail("A cancelled load must not be delivered")
+            }
+        }
+        requests.forEach { $0.cancel() }
+        
+        // A new load of the same placement performs a new ad call.
+        let loaded = expectation(description: "The new load is delivered")
+        coalescer.loadBannerView(with: Self.AD_PLACEMENT) { _ in
+            loaded.fulfill()
+        }
+        wait(for: [loaded], timeout: 1.0)
+        
+        XCTAssertEqual(server.adCallCount, 2)
+        XCTAssertEqual(coalescer.counters.abandonedLoads, 1)
+    }
+    
+    @MainActor
+    func testConcurrentAwaitedLoadsPerformOneAdCall() async {
+        let server = SASAdServerSimulator(profile: Self.PROFILE)
+        let coalescer = SASAdLoadCoalescer(loader: server)
+        
+        let results = await coalescer.loadBannerViews(with: Array(repeating: Self.AD_PLACEMENT, count: Self.LOAD_COUNT))
+        
+        XCTAssertEqual(results.compactMap { try? $0.get() }.count, Self.LOAD_COUNT)
+        XCTAssertEqual(server.adCallCount, 1)
+    }
+    
+}
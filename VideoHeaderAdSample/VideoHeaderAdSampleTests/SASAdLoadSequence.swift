@@ -0,0 +1,92 @@
+//
+//  SASAdLoadSequence.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import UIKit
+import XCTest
+import SASDisplayKit
+@testable import VideoHeaderAdSample
+
+/**
+ Banner loads performed through a coalescer one after the other, each one starting once the previous one has returned,
+ like the header ad of a screen opened again and again.
+ */
+struct SASAdLoadSequence {
+    
+    /// A load of the sequence.
+    struct Load {
+        /// The time (in seconds) after which the load has returned.
+        let duration: TimeInterval
+        
+        /// The loading error, or nil if an ad has been loaded.
+        let error: (any Error)?
+        
+        /// Whether an ad has been loaded.
+        var succeeded: Bool {
+            return error == nil
+        }
+    }
+    
+    /// Summary of the loads of a sequence.
+    struct Summary {
+        /// Ratio of loads returning an ad.
+        let fillRate: Double
+        
+        /// Time-to-display of the loads returning an ad.
+        let timeToDisplay: SASAdLoadGenerator.Percentiles
+        
+        /// Time until the outcome of every load is known.
+        let timeToOutcome: SASAdLoadGenerator.Percentiles
+        
+        init(_ loads: ArraySlice<Load>) {
+            fillRate = loads.isEmpty ? 0.0 : Double(loads.filter(\.succeeded).count) / Double(loads.count)
+            timeToDisplay = SASAdLoadGenerator.Percentiles(loads.filter(\.succeeded).map(\.duration))
+            timeToOutcome = SASAdLoadGenerator.Percentiles(loads.map(\.duration))
+        }
+    }
+    
+    /// The coalescer performing the loads.
+    let coalescer: SASAdLoadCoalescer
+    
+    /// The ad placement of the loads.
+    let adPlacement: SASAdPlacement
+    
+    /**
+     Performs the loads of the sequence, waiting for the last one to return.
+     
+     @param count The number of loads.
+     @param testCase The test case waiting for the loads.
+     @param timeout The time (in seconds) after which the test case stops waiting.
+     @return The loads, in the order they have been performed.
+     */
+    func run(count: Int, in testCase: XCTestCase, timeout: TimeInterval) -> [Load] {
+        let finished = testCase.expectation(description: "Every load of the sequence has returned")
+        var loads = [Load]()
+        loads.reserveCapacity(count)
+        
+        func loadNext() {
+            guard loads.count < count else {
+                finished.fulfill()
+                return
+            }
+            
+            let start = CACurrentMediaTime()
+            coalescer.loadBannerView(with: adPlacement) { result in
+                var error: (any Error)? = nil
+                if case .failure(let loadError) = result {
+                    error = loadError
+                }
+                loads.append(Load(duration: CACurrentMediaTime() - start, error: error))
+                loadNext()
+            }
+        }
+        loadNext()
+        
+        testCase.wait(for: [finished], timeout: timeout)
+        return loads
+    }
+    
+}
@@ -0,0 +1,102 @@
+//
+//  SASAdPlacementKeyBenchmarks.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import XCTest
+import SASDisplayKit
+@testable import VideoHeaderAdSample
+
+/**
+ Benchmark of the placement key with growing targetings: building a key is O(n) in the number of segments, while
+ hashing and comparing interned keys must stay O(1).
+ */
+final class SASAdPlacementKeyBenchmarks: XCTestCase {
+    
+    // MARK: - Constants
+    
+    private static let SEGMENT_COUNTS = [10, 1_000, 10_000]
+    
+    /// Number of dictionary lookups per measure, like the lookups of the coalescer and the prefetch cache on each load.
+    private static let LOOKUP_COUNT = 100_000
+    
+    /// Number of other placements in the looked up dictionary.
+    private static let PLACEMENT_COUNT = 100
+    
+    // MARK: - Benchmarks
+    
+    func testLookupCostDoesNotGrowWithSegments() {
+        for segmentCount in Self.SEGMENT_COUNTS {
+            let adPlacement = SASSellerDefinedFixture.adPlacement(segmentCount: segmentCount)
+            
+            let buildStart = DispatchTime.now().uptimeNanoseconds
+            let key = SASAdPlacementKey(adPlacement: adPlacement)
+            let buildDuration = Self.seconds(since: buildStart)
+            
+            let keys = Self.otherKeys(segmentCount: segmentCount) + [key]
+            let lookupStart = DispatchTime.now().uptimeNanoseconds
+            let hitCount = Self.lookUp(adPlacement, count: Self.LOOKUP_COUNT, in: Self.dictionary(of: keys))
+            let lookupDuration = Self.seconds(since: lookupStart)
+            
+            print("[benchmark] placement key (\(segmentCount) segments, \(key.canonicalBytes.count) bytes): built in \(Int(buildDuration * 1_000_000.0)) µs, \(Int(lookupDuration / Double(Self.LOOKUP_COUNT) * 1_000_000_000.0)) ns per lookup")
+            
+            // Every lookup hits the key, whose cached value is not rebuilt.
+            XCTAssertEqual(hitCount, Self.LOOKUP_COUNT)
+            XCTAssertEqual(adPlacement.placementKey, key)
+        }
+    }
+    
+    func testLookupWithTenThousandSegments() {
+        let adPlacement = SASSellerDefinedFixture.adPlacement(segmentCount: 10_000)
+        let keys = Self.otherKeys(segmentCount: 10_000) + [adPlacement.placementKey]
+        let dictionary = Self.dictionary(of: keys)
+        
+        let options = XCTMeasureOptions()
+        options.invocationOptions = [.manuallyStart, .manuallyStop]
+        measure(metrics: [XCTClockMetric()], options: options) {
+            startMeasuring()
+            _ = Self.lookUp(adPlacement, count: Self.LOOKUP_COUNT, in: dictionary)
+            stopMeasuring()
+        }
+    }
+    
+    func testKeyBuildWithTenThousandSegments() {
+        let adPlacement = SASSellerDefinedFixture.adPlacement(segmentCount: 10_000)
+        
+        let options = XCTMeasureOptions()
+        options.invocationOptions = [.manuallyStart, .manuallyStop]
+        measure(metrics: [XCTClockMetric()], options: options) {
+            startMeasuring()
+            _ = SASAdPlacementKey(adPlacement: adPlacement)
+            stopMeasuring()
+        }
+    }
+    
+    // MARK: - Private methods
+    
+    /// Returns the keys of other placements with the same number of segments, differing by their keyword targeting.
+    private static func otherKeys(segmentCount: Int) -> [SASAdPlacementKey] {
+        return (0..<PLACEMENT_COUNT).map { index in
+            SASSellerDefinedFixture.adPlacement(segmentCount: segmentCount, keywordTargeting: "other=\(index)").placementKey
+        }
+    }
+    
+    private static func dictionary(of keys: [SASAdPlacementKey]) -> [SASAdPlacementKey: Int] {
+        return Dictionary(keys.enumerated().map { ($1, $0) }, uniquingKeysWith: { first, _ in first })
+    }
+    
+    private static func lookUp(_ adPlacement: SASAdPlacement, count: Int, in dictionary: [SASAdPlacementKey: Int]) -> Int {
+        var hitCount = 0
+        for _ in 0..<count where dictionary[adPlacement.placementKey] != nil {
+            hitCount += 1
+        }
+        return hitCount
+    }
+    
+    private static func seconds(since start: UInt64) -> TimeInterval {
+        return TimeInterval(DispatchTime.now().uptimeNanoseconds - start) / 1_000_000_000.0
+    }
+    
+}
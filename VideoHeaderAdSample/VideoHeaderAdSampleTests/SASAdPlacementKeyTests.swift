@@ -0,0 +1,124 @@
+//
+//  SASAdPlacementKeyTests.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import XCTest
+import SASDisplayKit
+@testable import VideoHeaderAdSample
+
+/**
+ Tests of the placement key: canonical serialization, interning and caching on the placement.
+ */
+final class SASAdPlacementKeyTests: XCTestCase {
+    
+    // MARK: - Constants
+    
+    /// Number of segments of the large targetings, like the lists pushed by a data team.
+    private static let SEGMENT_COUNT = 5_000
+    
+    /// Number of transient keys created by the pruning test, well above the pruning threshold of the intern table.
+    private static let TRANSIENT_KEY_COUNT = 10_000
+    
+    /// Pruning threshold of the intern table.
+    private static let PRUNE_THRESHOLD = 1_024
+    
+    // MARK: - Tests
+    
+    func testIdenticalTargetingsShareTheSameKey() {
+        let key = SASAdPlacementKey(adPlacement: SASSellerDefinedFixture.adPlacement(segmentCount: Self.SEGMENT_COUNT))
+        let otherKey = SASAdPlacementKey(adPlacement: SASSellerDefinedFixture.adPlacement(segmentCount: Self.SEGMENT_COUNT))
+        
+        XCTAssertEqual(key, otherKey)
+        XCTAssertEqual(key.hash64, otherKey.hash64)
+        XCTAssertEqual(key.hashValue, otherKey.hashValue)
+        XCTAssertEqual(key.canonicalBytes, otherKey.canonicalBytes)
+    }
+    
+    func testAnySegmentChangesTheKey() {
+        let adPlacement = SASSellerDefinedFixture.adPlacement(segmentCount: Self.SEGMENT_COUNT)
+        let key = SASAdPlacementKey(adPlacement: adPlacement)
+        
+        // Only the value of the very last segment differs.
+        let otherAdPlacement = SASSellerDefinedFixture.adPlacement(segmentCount: Self.SEGMENT_COUNT)
+        var contents = otherAdPlacement.sellerDefinedContents!
+        var segments = contents[contents.count - 1].segments!
+        segments[segments.count - 1] = SASSellerDefinedSegment(id: "other", name: "other", value: "other")
+        contents[contents.count - 1] = SASSellerDefinedContent(id: contents[contents.count - 1].id, name: contents[contents.count - 1].name, segments: segments)
+        otherAdPlacement.sellerDefinedContents = contents
+        
+        XCTAssertNotEqual(key, SASAdPlacementKey(adPlacement: otherAdPlacement))
+        XCTAssertNotEqual(key.hash64, SASAdPlacementKey(adPlacement: otherAdPlacement).hash64)
+    }
+    
+    func testFieldBoundariesAreNotAmbiguous() {
+        let adPlacement = SASAdPlacement(siteId: 507206, pageId: 1579908, formatId: 15048, keywordTargeting: nil)
+        adPlacement.sellerDefinedAudiences = [SASSellerDefinedAudience(id: "ab", name: "c", segments: nil)]
+        let otherAdPlacement = SASAdPlacement(siteId: 507206, pageId: 1579908, formatId: 15048, keywordTargeting: nil)
+        otherAdPlacement.sellerDefinedAudiences = [SASSellerDefinedAudience(id: "a", name: "bc", segments: nil)]
+        
+        XCTAssertNotEqual(SASAdPlacementKey(adPlacement: adPlacement), SASAdPlacementKey(adPlacement: otherAdPlacement))
+    }
+    
+    func testMissingAndEmptyFieldsAreDistinct() {
+        let adPlacement = SASAdPlacement(siteId: 507206, pageId: 1579908, formatId: 15048, keywordTargeting: nil)
+        let emptyAdPlacement = SASAdPlacement(siteId: 507206, pageId: 1579908, formatId: 15048, keywordTargeting: "")
+        emptyAdPlacement.sellerDefinedAudiences = []
+        
+        XCTAssertNotEqual(SASAdPlacementKey(adPlacement: adPlacement), SASAdPlacementKey(adPlacement: emptyAdPlacement))
+    }
+    
+    func testReleasedKeysArePrunedFromTheInternTable() {
+        // Keys kept alive during the churn must survive the pruning.
+        let liveAdPlacements = (0..<10).map { index in
+            SASAdPlacement(siteId: 507206, pageId: 1579908, formatId: 15048, keywordTargeting: "live=\(index)")
+        }
+        let liveKeys = liveAdPlacements.map { SASAdPlacementKey(adPlacement: $0) }
+        let initialCount = SASAdPlacementKey.internedHashCount
+        
+        for index in 0..<Self.TRANSIENT_KEY_COUNT {
+            _ = SASAdPlacementKey(adPlacement: SASAdPlacement(siteId: 507206, pageId: 1579908, formatId: 15048, keywordTargeting: "transient=\(index)"))
+        }
+        
+        // Without pruning, the table would hold every transient hash.
+        XCTAssertLessThan(SASAdPlacementKey.internedHashCount, initialCount + 2 * Self.PRUNE_THRESHOLD)
+        XCTAssertEqual(liveAdPlacements.map { SASAdPlacementKey(adPlacement: $0) }, liveKeys)
+    }
+    
+    func testMutatedPlacementGetsNewKey() {
+        let adPlacement = SASSellerDefinedFixture.adPlacement(segmentCount: Self.SEGMENT_COUNT)
+        let key = adPlacement.placementKey
+        XCTAssertEqual(adPlacement.placementKey, key)
+        
+        adPlacement.supplyChainObjectString = "1.0,1!exchange1.com,1234,1"
+        let supplyChainKey = adPlacement.placementKey
+        XCTAssertNotEqual(supplyChainKey, key)
+        XCTAssertEqual(supplyChainKey, SASAdPlacementKey(adPlacement: adPlacement))
+        
+        adPlacement.sellerDefinedAudiences = SASSellerDefinedFixture.audiences(segmentCount: 10)
+        let audiencesKey = adPlacement.placementKey
+        XCTAssertNotEqual(audiencesKey, supplyChainKey)
+        XCTAssertEqual(audiencesKey, SASAdPlacementKey(adPlacement: adPlacement))
+        
+        adPlacement.sellerDefinedContents = nil
+        XCTAssertNotEqual(adPlacement.placementKey, audiencesKey)
+        XCTAssertEqual(adPlacement.placementKey, SASAdPlacementKey(adPlacement: adPlacement))
+    }
+    
+    func testRestoredTargetingGetsOriginalKey() {
+        let adPlacement = SASSellerDefinedFixture.adPlacement(segmentCount: Self.SEGMENT_COUNT)
+        let audiences = adPlacement.sellerDefinedAudiences
+        let key = adPlacement.placementKey
+        
+        // Setting an equal targeting, even as new objects, gives back the same interned key.
+        adPlacement.sellerDefinedAudiences = []
+        XCTAssertNotEqual(adPlacement.placementKey, key)
+        adPlacement.sellerDefinedAudiences = audiences
+        XCTAssertEqual(adPlacement.placementKey, key)
+        adPlacement.sellerDefinedAudiences = SASSellerDefinedFixture.audiences(segmentCount: Self.SEGMENT_COUNT / 2)
+        XCTAssertEqual(adPlacement.placementKey, key)
+    }
+    
+}
@@ -0,0 +1,154 @@
+//
+//  SASAdPrefetchCacheTests.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import UIKit
+import XCTest
+import SASDisplayKit
+@testable import VideoHeaderAdSample
+
+/**
+ Tests of the prefetch cache, prefetching its ads through a coalescer from the ad server simulator.
+ */
+final class SASAdPrefetchCacheTests: XCTestCase {
+    
+    // MARK: - Constants
+    
+    private static let AD_PLACEMENT = SASAdPlacement(siteId: 507206, pageId: 1579908, formatId: 15048, keywordTargeting: "prefetch")
+    
+    private static let PROFILE = SASAdServerSimulator.Profile(latency: .constant(0.01))
+    
+    // MARK: - Tests
+    
+    func testPrefetchedAdIsHit() {
+        let server = SASAdServerSimulator(profile: Self.PROFILE)
+        let coalescer = SASAdLoadCoalescer(loader: server)
+        let cache = SASAdPrefetchCache(coalescer: coalescer)
+        
+        cache.prefetchAd(with: Self.AD_PLACEMENT)
+        waitForLoad(of: Self.AD_PLACEMENT, with: coalescer)
+        
+        // The ad is taken once: the next request is a miss.
+        XCTAssertNotNil(cache.takeAd(for: Self.AD_PLACEMENT))
+        XCTAssertNil(cache.takeAd(for: Self.AD_PLACEMENT))
+        XCTAssertEqual(cache.counters, SASAdPrefetchCache.Counters(hits: 1, misses: 1, prefetches: 1))
+        XCTAssertEqual(server.adCallCount, 1)
+    }
+    
+    func testAdNotPrefetchedOrStillLoadingIsMissed() {
+        let server = SASAdServerSimulator(profile: Self.PROFILE)
+        let cache = SASAdPrefetchCache(coalescer: SASAdLoadCoalescer(loader: server))
+        
+        XCTAssertNil(cache.takeAd(for: Self.AD_PLACEMENT))
+        cache.prefetchAd(with: Self.AD_PLACEMENT)
+        XCTAssertNil(cache.takeAd(for: Self.AD_PLACEMENT))
+        
+        XCTAssertEqual(cache.counters, SASAdPrefetchCache.Counters(misses: 2, prefetches: 1))
+    }
+    
+    func testReadyAdIsNotPrefetchedAgain() {
+        let server = SASAdServerSimulator(profile: Self.PROFILE)
+        let coalescer = SASAdLoadCoalescer(loader: server)
+        let cache = SASAdPrefetchCache(coalescer: coalescer)
+        
+        cache.prefetchAd(with: Self.AD_PLACEMENT)
+        cache.prefetchAd(with: Self.AD_PLACEMENT)
+        waitForLoad(of: Self.AD_PLACEMENT, with: coalescer)
+        cache.prefetchAd(with: Self.AD_PLACEMENT)
+        
+        XCTAssertEqual(cache.counters.prefetches, 1)
+        XCTAssertEqual(server.adCallCount, 1)
+    }
+    
+    func testExpiredAdIsDiscarded() {
+        let server = SASAdServerSimulator(profile: Self.PROFILE)
+        let coalescer = SASAdLoadCoalescer(loader: server)
+        let cache = SASAdPrefetchCache(coalescer: coalescer)
+        cache.timeToLive = 0.05
+        
+        cache.prefetchAd(with: Self.AD_PLACEMENT)
+        waitForLoad(of: Self.AD_PLACEMENT, with: coalescer)
+        wait(seconds: 0.1)
+        
+        XCTAssertNil(cache.takeAd(for: Self.AD_PLACEMENT))
+        XCTAssertEqual(cache.counters, SASAdPrefetchCache.Counters(expirations: 1, prefetches: 1))
+        
+        // The expired ad is replaced by a new prefetch.
+        cache.prefetchAd(with: Self.AD_PLACEMENT)
+        XCTAssertEqual(server.adCallCount, 2)
+    }
+    
+    func testFailedPrefetchIsDiscarded() {
+        let server = SASAdServerSimulator(profile: SASAdServerSimulator.Profile(latency: .constant(0.01), noFillRate: 1.0))
+        let coalescer = SASAdLoadCoalescer(loader: server)
+        let cache = SASAdPrefetchCache(coalescer: coalescer)
+        
+        cache.prefetchAd(with: Self.AD_PLACEMENT)
+        waitForLoad(of: Self.AD_PLACEMENT, with: coalescer)
+        
+        XCTAssertNil(cache.takeAd(for: Self.AD_PLACEMENT))
+        XCTAssertEqual(cache.counters, SASAdPrefetchCache.Counters(misses: 1, prefetches: 1, failures: 1))
+    }
+    
+    func testAdClaimedByAnotherWaiterIsEvicted() {
+        let server = SASAdServerSimulator(profile: Self.PROFILE)
+        let coalescer = SASAdLoadCoalescer(loader: server)
+        let cache = SASAdPrefetchCache(coalescer: coalescer)
+        
+        // An ad cell attached to the load of the prefetch displays the ad as soon as it is loaded.
+        cache.prefetchAd(with: Self.AD_PLACEMENT)
+        let claimed = expectation(description: "The ad has been claimed by the other waiter")
+        coalescer.loadBannerView(with: Self.AD_PLACEMENT) { result in
+            XCTAssertEqual(try? result.get().claim(), true)
+            claimed.fulfill()
+        }
+        wait(for: [claimed], timeout: 1.0)
+        
+        XCTAssertNil(cache.takeAd(for: Self.AD_PLACEMENT))
+        XCTAssertEqual(cache.counters, SASAdPrefetchCache.Counters(misses: 1, prefetches: 1, claimEvictions: 1))
+        XCTAssertEqual(server.adCallCount, 1)
+    }
+    
+    @MainActor
+    func testAdCellAdoptsPrefetchedAd() async throws {
+        let server = SASAdServerSimulator(profile: Self.PROFILE)
+        let coalescer = SASAdLoadCoalescer(loader: server)
+        let cache = SASAdPrefetchCache(coalescer: coalescer)
+        
+        cache.prefetchAd(with: Self.AD_PLACEMENT)
+        _ = try await coalescer.loadBannerView(with: Self.AD_PLACEMENT)
+        
+        let nib = UINib(nibName: SASVideoHeaderAdCell.NIB_NAME, bundle: Bundle(for: SASVideoHeaderAdCell.self))
+        let adCell = nib.instantiate(withOwner: nil).compactMap { $0 as? SASVideoHeaderAdCell }.first!
+        adCell.prefetchCache = cache
+        adCell.loadCoalescer = coalescer
+        _ = try await adCell.loadAd(with: Self.AD_PLACEMENT)
+        
+        // The ad cell has displayed the prefetched ad, without any ad call of its own.
+        XCTAssertEqual(cache.counters.hits, 1)
+        XCTAssertEqual(server.adCallCount, 1)
+    }
+    
+    // MARK: - Private methods
+    
+    /// Waits for the load in flight for the placement to return, by attaching another waiter to it.
+    private func waitForLoad(of adPlacement: SASAdPlacement, with coalescer: SASAdLoadCoalescer) {
+        let loaded = expectation(description: "The load in flight has returned")
+        coalescer.loadBannerView(with: adPlacement) { _ in
+            loaded.fulfill()
+        }
+        wait(for: [loaded], timeout: 1.0)
+    }
+    
+    private func wait(seconds: TimeInterval) {
+        let elapsed = expectation(description: "The delay has elapsed")
+        DispatchQueue.main.asyncAfter(deadline: .now() + seconds) {
+            elapsed.fulfill()
+        }
+        wait(for: [elapsed], timeout: seconds + 1.0)
+    }
+    
+}
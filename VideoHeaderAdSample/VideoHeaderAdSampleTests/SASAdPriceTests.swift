@@ -0,0 +1,126 @@
+//
+//  SASAdPriceTests.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import Foundation
+import XCTest
+#if canImport(VideoHeaderAdCore)
+@testable import VideoHeaderAdCore
+#else
+@testable import VideoHeaderAdSample
+#endif
+
+/**
+ Tests of the parsing of prices and currency codes, and of the conversion of prices to the reporting currency.
+ */
+final class SASAdPriceTests: XCTestCase {
+    
+    // MARK: - Constants
+    
+    /// Largest price that can be represented, in its string form.
+    private static let MAX_PRICE = "9223372036854.775807"
+    
+    // MARK: - Price parsing
+    
+    func testValidPricesAreParsed() {
+        XCTAssertEqual(SASAdPrice("12")?.microUnits, 12_000_000)
+        XCTAssertEqual(SASAdPrice("0.35")?.microUnits, 350_000)
+        XCTAssertEqual(SASAdPrice(".5")?.microUnits, 500_000)
+        XCTAssertEqual(SASAdPrice("5.")?.microUnits, 5_000_000)
+        XCTAssertEqual(SASAdPrice("0.000001")?.microUnits, 1)
+        XCTAssertEqual(SASAdPrice("007.250")?.microUnits, 7_250_000)
+        
+        // Substrings and raw UTF-8 bytes are parsed the same way.
+        XCTAssertEqual(SASAdPrice("CPM=1.25".split(separator: "=")[1])?.microUnits, 1_250_000)
+        XCTAssertEqual(SASAdPrice.parse(utf8: Array("1.25".utf8))?.microUnits, 1_250_000)
+    }
+    
+    func testSeventhFractionDigitIsRoundedHalfUp() {
+        XCTAssertEqual(SASAdPrice("1.0000004")?.microUnits, 1_000_000)
+        XCTAssertEqual(SASAdPrice("1.0000005")?.microUnits, 1_000_001)
+        XCTAssertEqual(SASAdPrice("0.0000005")?.microUnits, 1)
+        
+        // The digits after the seventh one are ignored: they can neither round a 4 up nor a 5 down.
+        XCTAssertEqual(SASAdPrice("1.00000049999")?.microUnits, 1_000_000)
+        XCTAssertEqual(SASAdPrice("1.00000050000")?.microUnits, 1_000_001)
+        
+        // The rounding carries over to the integer part.
+        XCTAssertEqual(SASAdPrice("0.9999995"), SASAdPrice("1.000000"))
+        XCTAssertEqual(SASAdPrice("0.9999995")?.microUnits, 1_000_000)
+        XCTAssertEqual(SASAdPrice("0.9999994")?.microUnits, 999_999)
+    }
+    
+    func testInvalidPricesAreRejected() {
+        for string in ["", ".", "-1", "+1", "1e3", "1E3", "1,5", " 1", "1 ", "1.2.3", "0x10", "NaN", "١"] {
+            XCTAssertNil(SASAdPrice(string), "'\(string)' must be rejected")
+        }
+    }
+    
+    func testOverflowingPricesAreRejected() {
+        XCTAssertEqual(SASAdPrice(Self.MAX_PRICE)?.microUnits, Int64.max)
+        
+        // Overflow of the fraction, of the scaled integer part, of the integer part itself, and of the rounding.
+        XCTAssertNil(SASAdPrice("9223372036854.775808"))
+        XCTAssertNil(SASAdPrice("9223372036855"))
+        XCTAssertNil(SASAdPrice("99999999999999999999"))
+        XCTAssertNil(SASAdPrice(Self.MAX_PRICE + "5"))
+        XCTAssertEqual(SASAdPrice(Self.MAX_PRICE + "4")?.microUnits, Int64.max)
+    }
+    
+    // MARK: - Currencies
+    
+    func testCurrencyCodesAreCaseInsensitive() {
+        XCTAssertEqual(SASCurrency(code: "EUR"), .EUR)
+        XCTAssertEqual(SASCurrency(code: "eur"), .EUR)
+        XCTAssertEqual(SASCurrency(code: "uSd"), .USD)
+        XCTAssertEqual(SASCurrency(code: "gbp")?.code, "GBP")
+        XCTAssertEqual(SASCurrency(code: "chf")?.description, "CHF")
+    }
+    
+    func testUnknownCurrencyCodesAreRejected() {
+        for code in ["", "EU", "EURO", "XYZ", "E1R", "ÉUR", " EUR"] {
+            XCTAssertNil(SASCurrency(code: code), "'\(code)' must be rejected")
+        }
+    }
+    
+    // MARK: - Conversion
+    
+    func testPricesAreConvertedHalfUp() {
+        let converter = SASAdPriceConverter(reportingCurrency: .EUR, exchangeRates: [.USD: SASAdPrice(microUnits: 500_000)])
+        
+        XCTAssertEqual(converter.convert(SASAdPrice(microUnits: 2_000_001), from: .USD)?.microUnits, 1_000_001)
+        XCTAssertEqual(converter.convert(SASAdPrice(microUnits: 2_000_000), from: .USD)?.microUnits, 1_000_000)
+        XCTAssertEqual(converter.convert(SASAdPrice(microUnits: 1_234_567), from: .EUR)?.microUnits, 1_234_567)
+    }
+    
+    func testUnconvertiblePricesReturnNil() {
+        var converter = SASAdPriceConverter(reportingCurrency: .EUR, exchangeRates: [.USD: SASAdPrice(microUnits: 2_000_000)])
+        converter.setExchangeRate(SASAdPrice(microUnits: -1), for: .GBP)
+        
+        // No exchange rate (negative rates are ignored), and negative prices.
+        XCTAssertNil(converter.convert(SASAdPrice(microUnits: 1_000_000), from: .GBP))
+        XCTAssertNil(converter.convert(SASAdPrice(microUnits: -1_000_000), from: .USD))
+    }
+    
+    func testOverflowingConversionReturnsNil() {
+        let converter = SASAdPriceConverter(reportingCurrency: .EUR, exchangeRates: [.USD: SASAdPrice(microUnits: 2_000_000)])
+        let largestPrice = SASAdPrice(microUnits: Int64.max / 2)
+        let overflowingPrice = SASAdPrice(microUnits: Int64.max / 2 + 1)
+        
+        XCTAssertEqual(converter.convert(largestPrice, from: .USD)?.microUnits, Int64.max - 1)
+        XCTAssertNil(converter.convert(overflowingPrice, from: .USD))
+        XCTAssertNil(converter.convert(SASAdPrice(microUnits: Int64.max), from: .USD))
+        
+        // The batch conversion returns the same prices, whether the overflowing price is in a vector or not.
+        let smallPrices = (1...8).map { SASAdPrice(microUnits: Int64($0)) }
+        let prices = smallPrices + [overflowingPrice, largestPrice] + smallPrices
+        let records = prices.map { SASAdPriceConverter.Record(price: $0, currency: .USD) }
+        let expectedPrices: [SASAdPrice?] = prices.map { $0 == overflowingPrice ? nil : SASAdPrice(microUnits: $0 == largestPrice ? Int64.max - 1 : $0.microUnits * 2) }
+        XCTAssertEqual(converter.convert(records, vectorized: true), expectedPrices)
+        XCTAssertEqual(converter.convert(records, vectorized: false), expectedPrices)
+    }
+    
+}
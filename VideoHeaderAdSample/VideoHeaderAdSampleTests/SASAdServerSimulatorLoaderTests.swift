@@ -0,0 +1,88 @@
+//
+//  SASAdServerSimulatorLoaderTests.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import XCTest
+import SASDisplayKit
+@testable import VideoHeaderAdSample
+
+/**
+ Tests of the coalescer loading its ads from the ad server simulator.
+ */
+final class SASAdServerSimulatorLoaderTests: XCTestCase {
+    
+    // MARK: - Constants
+    
+    private static let AD_PLACEMENT = SASAdPlacement(siteId: 507206, pageId: 1579908, formatId: 15048, keywordTargeting: "simulator")
+    
+    // MARK: - Tests
+    
+    func testLoadedAdIsDelivered() {
+        let server = SASAdServerSimulator(profile: SASAdServerSimulator.Profile(latency: .constant(0.01)))
+        let coalescer = SASAdLoadCoalescer(loader: server)
+        
+        let result = load(with: coalescer)
+        
+        XCTAssertTrue(try result.get().claim())
+        XCTAssertEqual(server.adCallCount, 1)
+        XCTAssertEqual(coalescer.counters.adCalls, 1)
+    }
+    
+    func testNoFillIsReportedAsSimulatorError() {
+        let server = SASAdServerSimulator(profile: SASAdServerSimulator.Profile(latency: .constant(0.01), noFillRate: 1.0))
+        
+        let error = failure(of: load(with: SASAdLoadCoalescer(loader: server)))
+        
+        XCTAssertEqual(error?.domain, SASAdServerSimulator.ERROR_DOMAIN)
+        XCTAssertEqual(error?.code, SASAdServerSimulator.NO_FILL_ERROR_CODE)
+    }
+    
+    func testServerErrorIsReportedAsNetworkError() {
+        let server = SASAdServerSimulator(profile: SASAdServerSimulator.Profile(latency: .constant(0.01), errorRate: 1.0))
+        
+        let error = failure(of: load(with: SASAdLoadCoalescer(loader: server)))
+        
+        XCTAssertEqual(error?.domain, NSURLErrorDomain)
+    }
+    
+    func testCancelledLoadIsNotDelivered() {
+        let server = SASAdServerSimulator(profile: SASAdServerSimulator.Profile(latency: .constant(0.01)))
+        let coalescer = SASAdLoadCoalescer(loader: server)
+        let notDelivered = expectation(description: "The cancelled load is not delivered")
+        notDelivered.isInverted = true
+        
+        coalescer.loadBannerView(with: Self.AD_PLACEMENT) { _ in
+            notDelivered.fulfill()
+        }.cancel()
+        
+        wait(for: [notDelivered], timeout: 0.1)
+        XCTAssertEqual(coalescer.counters.abandonedLoads, 1)
+    }
+    
+    // MARK: - Private methods
+    
+    private func load(with coalescer: SASAdLoadCoalescer) -> Result<SASCoalescedAd<SASBannerView>, any Error> {
+        let loaded = expectation(description: "The load has returned")
+        var loadResult: Result<SASCoalescedAd<SASBannerView>, any Error>?
+        
+        coalescer.loadBannerView(with: Self.AD_PLACEMENT) { result in
+            loadResult = result
+            loaded.fulfill()
+        }
+        
+        wait(for: [loaded], timeout: 1.0)
+        return loadResult ?? .failure(CancellationError())
+    }
+    
+    private func failure(of result: Result<SASCoalescedAd<SASBannerView>, any Error>) -> NSError? {
+        guard case .failure(let error) = result else {
+            XCTFail("The load should have failed")
+            return nil
+        }
+        return error as NSError
+    }
+    
+}
@@ -0,0 +1,119 @@
+//
+//  SASAdServerSimulatorTests.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import Foundation
+import XCTest
+#if canImport(VideoHeaderAdCore)
+@testable import VideoHeaderAdCore
+#else
+@testable import VideoHeaderAdSample
+#endif
+
+/**
+ Tests of the ad server simulator and of the load generator driving it.
+ */
+final class SASAdServerSimulatorTests: XCTestCase {
+    
+    // MARK: - Constants
+    
+    private static let DRAW_COUNT = 100_000
+    
+    // MARK: - Simulator
+    
+    func testSameSeedDrawsSameResponses() {
+        let profile = SASAdServerSimulator.Profile(errorRate: 0.1, noFillRate: 0.2, slowBodyRate: 0.1)
+        let first = SASAdServerSimulator(profile: profile, seed: 42)
+        let second = SASAdServerSimulator(profile: profile, seed: 42)
+        
+        for _ in 0..<1_000 {
+            XCTAssertEqual(first.drawResponse(timeout: 1.0), second.drawResponse(timeout: 1.0))
+        }
+        XCTAssertEqual(first.adCallCount, 1_000)
+    }
+    
+    func testOutcomesFollowProfileRates() {
+        let profile = SASAdServerSimulator.Profile(errorRate: 0.2, noFillRate: 0.3)
+        let report = SASAdLoadGenerator(server: SASAdServerSimulator(profile: profile)).run(count: Self.DRAW_COUNT)
+        
+        XCTAssertEqual(rate(of: .error, in: report), 0.2, accuracy: 0.01)
+        XCTAssertEqual(rate(of: .noFill, in: report), 0.3, accuracy: 0.01)
+        XCTAssertEqual(report.fillRate, 0.5, accuracy: 0.01)
+    }
+    
+    func testResponsesExceedingTimeoutTimeOut() {
+        let profile = SASAdServerSimulator.Profile(latency: .constant(2.0))
+        let server = SASAdServerSimulator(profile: profile)
+        
+        XCTAssertEqual(server.drawResponse(timeout: 1.0), SASAdServerSimulator.Response(outcome: .timeout, duration: 1.0))
+        XCTAssertEqual(server.drawResponse(timeout: 3.0), SASAdServerSimulator.Response(outcome: .ad, duration: 2.0))
+        XCTAssertEqual(server.drawResponse(), SASAdServerSimulator.Response(outcome: .ad, duration: 2.0))
+    }
+    
+    func testErrorBurstsFailConsecutiveAdCalls() {
+        let profile = SASAdServerSimulator.Profile(errorBurstRate: 0.01, errorBurstLength: 5)
+        let server = SASAdServerSimulator(profile: profile)
+        
+        // Without any other error, every failure belongs to a burst: failures come in runs of at least 5 ad calls.
+        var runLengths = [Int]()
+        var currentRun = 0
+        for _ in 0..<Self.DRAW_COUNT {
+            if server.drawResponse().outcome == .error {
+                currentRun += 1
+            } else if currentRun > 0 {
+                runLengths.append(currentRun)
+                currentRun = 0
+            }
+        }
+        
+        XCTAssertFalse(runLengths.isEmpty)
+        XCTAssertTrue(runLengths.allSatisfy { $0 >= 5 })
+    }
+    
+    func testParetoLatencyIsHeavyTailed() {
+        let profile = SASAdServerSimulator.Profile(latency: .pareto(minimum: 0.1, shape: 1.5))
+        let report = SASAdLoadGenerator(server: SASAdServerSimulator(profile: profile)).run(count: Self.DRAW_COUNT)
+        
+        // The median of a Pareto distribution is minimum * 2^(1 / shape), its 99th percentile is far above it.
+        XCTAssertEqual(report.didLoad.p50, 0.1 * pow(2.0, 1.0 / 1.5), accuracy: 0.01)
+        XCTAssertGreaterThan(report.didLoad.p99, 10.0 * report.didLoad.p50)
+    }
+    
+    // MARK: - Load generator
+    
+    func testPercentiles() {
+        let percentiles = SASAdLoadGenerator.Percentiles((1...100).map { TimeInterval($0) })
+        
+        XCTAssertEqual(percentiles.count, 100)
+        XCTAssertEqual(percentiles.p50, 51.0)
+        XCTAssertEqual(percentiles.p95, 95.0)
+        XCTAssertEqual(percentiles.p99, 99.0)
+        XCTAssertEqual(SASAdLoadGenerator.Percentiles([]).count, 0)
+    }
+    
+    func testConcurrentRunReportsEveryAdCall() {
+        let profile = SASAdServerSimulator.Profile(latency: .uniform(0.001, 0.010), noFillRate: 0.5)
+        let server = SASAdServerSimulator(profile: profile)
+        let expectation = expectation(description: "Every ad call has completed")
+        
+        SASAdLoadGenerator(server: server).runConcurrently(count: 1_000) { report in
+            XCTAssertEqual(report.didLoad.count + report.didFailToLoad.count, 1_000)
+            XCTAssertGreaterThanOrEqual(report.didLoad.p50, 0.001)
+            expectation.fulfill()
+        }
+        
+        wait(for: [expectation], timeout: 10.0)
+        XCTAssertEqual(server.adCallCount, 1_000)
+    }
+    
+    // MARK: - Private methods
+    
+    private func rate(of outcome: SASAdServerSimulator.Outcome, in report: SASAdLoadGenerator.Report) -> Double {
+        let total = report.outcomes.values.reduce(0, +)
+        return Double(report.outcomes[outcome, default: 0]) / Double(total)
+    }
+    
+}
@@ -0,0 +1,193 @@
+//
+//  SASAdWaterfallLoaderTests.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import UIKit
+import XCTest
+import SASDisplayKit
+@testable import VideoHeaderAdSample
+
+/**
+ Tests of the waterfall loader, loading its steps through a coalescer from an ad server simulator per placement.
+ 
+ Latencies and timeouts are scaled down (a few milliseconds instead of a few hundred), so the waterfalls run in real
+ time quickly.
+ */
+final class SASAdWaterfallLoaderTests: XCTestCase {
+    
+    // MARK: - Constants
+    
+    private static let PRIMARY_PLACEMENT = SASAdPlacement(siteId: 507206, pageId: 1579908, formatId: 15048, keywordTargeting: "primary")
+    private static let BACKFILL_PLACEMENT = SASAdPlacement(siteId: 507206, pageId: 1579908, formatId: 15048, keywordTargeting: "backfill")
+    
+    // MARK: - Tests
+    
+    func testFirstStepReturningAnAdWins() {
+        let primary = SASAdServerSimulator(profile: SASAdServerSimulator.Profile(latency: .constant(0.01)))
+        let backfill = SASAdServerSimulator(profile: SASAdServerSimulator.Profile(latency: .constant(0.01)))
+        
+        let result = load(makeWaterfall(timeout: 0.1), primary: primary, backfill: backfill)
+        
+        // The primary step returns before the speculative start of the backfill step.
+        XCTAssertEqual(try result.get().stepIndex, 0)
+        XCTAssertEqual(backfill.adCallCount, 0)
+    }
+    
+    func testNextStepIsLoadedAfterNoFill() {
+        let primary = SASAdServerSimulator(profile: SASAdServerSimulator.Profile(latency: .constant(0.01), noFillRate: 1.0))
+        let backfill = SASAdServerSimulator(profile: SASAdServerSimulator.Profile(latency: .constant(0.01)))
+        
+        let result = load(makeWaterfall(timeout: 0.1), primary: primary, backfill: backfill)
+        
+        XCTAssertEqual(try result.get().stepIndex, 1)
+        XCTAssertTrue(try result.get().ad.isClaimed)
+        XCTAssertEqual(primary.adCallCount, 1)
+        XCTAssertEqual(backfill.adCallCount, 1)
+    }
+    
+    func testSpeculativeStartSavesTheRoundTripOfTheNextStep() {
+        // The primary step times out after 100 ms, the backfill step being started speculatively after 75 ms.
+        let primary = SASAdServerSimulator(profile: SASAdServerSimulator.Profile(latency: .constant(1.0)))
+        let backfill = SASAdServerSimulator(profile: SASAdServerSimulator.Profile(latency: .constant(0.05)))
+        
+        let start = CACurrentMediaTime()
+        let result = load(makeWaterfall(timeout: 0.1), primary: primary, backfill: backfill)
+        let duration = CACurrentMediaTime() - start
+        
+        XCTAssertEqual(try result.get().stepIndex, 1)
+        XCTAssertEqual(backfill.adCallCount, 1)
+        
+        // Without the speculative start, the backfill ad would have been returned after 150 ms.
+        XCTAssertLessThan(duration, 0.15)
+    }
+    
+    func testSpeculativeAdStaysUnclaimedUntilPreviousStepsFail() {
+        // The backfill ad is loaded after 50 ms, while the primary step only returns its ad after 100 ms.
+        let primary = SASAdServerSimulator(profile: SASAdServerSimulator.Profile(latency: .constant(0.1)))
+        let backfill = SASAdServerSimulator(profile: SASAdServerSimulator.Profile(latency: .constant(0.05)))
+        let coalescer = SASAdLoadCoalescer(loader: SASAdPlacementLoader(servers: [
+            Self.PRIMARY_PLACEMENT.placementKey: primary,
+            Self.BACKFILL_PLACEMENT.placementKey: backfill,
+        ]))
+        
+        // Another waiter (a prefetch for instance) is loading the backfill ad when the waterfall starts it speculatively.
+        var backfillAd: SASCoalescedAd<SASBannerView>? = nil
+        coalescer.loadBannerView(with: Self.BACKFILL_PLACEMENT) { result in
+            backfillAd = try? result.get()
+        }
+        
+        var waterfall = makeWaterfall(timeout: 0.5)
+        waterfall.speculativeStartRatio = 0.04
+        let result = load(waterfall, coalescer: coalescer)
+        
+        XCTAssertEqual(try result.get().stepIndex, 0)
+        XCTAssertEqual(coalescer.counters.coalescedLoads, 1)
+        
+        // The speculative ad has not been claimed by the waterfall: the other waiter can still display it.
+        XCTAssertEqual(backfillAd?.isClaimed, false)
+        XCTAssertEqual(backfillAd?.claim(), true)
+    }
+    
+    func testSpeculativeAdClaimedByAnotherWaiterFailsItsStep() {
+        // The primary step returns no ad after 100 ms, the backfill ad being loaded after 50 ms.
+        let primary = SASAdServerSimulator(profile: SASAdServerSimulator.Profile(latency: .constant(0.1), noFillRate: 1.0))
+        let backfill = SASAdServerSimulator(profile: SASAdServerSimulator.Profile(latency: .constant(0.05)))
+        let coalescer = SASAdLoadCoalescer(loader: SASAdPlacementLoader(servers: [
+            Self.PRIMARY_PLACEMENT.placementKey: primary,
+            Self.BACKFILL_PLACEMENT.placementKey: backfill,
+        ]))
+        
+        // Another waiter of the backfill load displays its ad as soon as it is loaded.
+        coalescer.loadBannerView(with: Self.BACKFILL_PLACEMENT) { result in
+            _ = try? result.get().claim()
+        }
+        
+        var waterfall = makeWaterfall(timeout: 0.5)
+        waterfall.speculativeStartRatio = 0.04
+        let result = load(waterfall, coalescer: coalescer)
+        
+        XCTAssertEqual(Self.loadingError(of: result), .adAlreadyClaimed)
+        XCTAssertEqual(backfill.adCallCount, 1)
+    }
+    
+    func testDeadlineFailsTheWaterfall() {
+        let primary = SASAdServerSimulator(profile: SASAdServerSimulator.Profile(latency: .constant(1.0)))
+        let backfill = SASAdServerSimulator(profile: SASAdServerSimulator.Profile(latency: .constant(1.0)))
+        
+        var waterfall = makeWaterfall(timeout: 0.5)
+        waterfall.deadline = 0.1
+        let result = load(waterfall, primary: primary, backfill: backfill)
+        
+        XCTAssertEqual(Self.loadingError(of: result), .deadlineExceeded)
+    }
+    
+    func testLastStepTimeoutFailsTheWaterfall() {
+        let primary = SASAdServerSimulator(profile: SASAdServerSimulator.Profile(latency: .constant(0.01), errorRate: 1.0))
+        let backfill = SASAdServerSimulator(profile: SASAdServerSimulator.Profile(latency: .constant(1.0)))
+        
+        let result = load(makeWaterfall(timeout: 0.1), primary: primary, backfill: backfill)
+        
+        XCTAssertEqual(Self.loadingError(of: result), .stepTimedOut)
+    }
+    
+    // MARK: - Private methods
+    
+    private func makeWaterfall(timeout: TimeInterval) -> SASAdWaterfall {
+        return SASAdWaterfall(steps: [
+            SASAdWaterfall.Step(adPlacement: Self.PRIMARY_PLACEMENT, timeout: timeout),
+            SASAdWaterfall.Step(adPlacement: Self.BACKFILL_PLACEMENT, timeout: timeout),
+        ], deadline: 1.0)
+    }
+    
+    private func load(_ waterfall: SASAdWaterfall, primary: SASAdServerSimulator, backfill: SASAdServerSimulator) -> Result<(ad: SASCoalescedAd<SASBannerView>, stepIndex: Int), any Error> {
+        let coalescer = SASAdLoadCoalescer(loader: SASAdPlacementLoader(servers: [
+            Self.PRIMARY_PLACEMENT.placementKey: primary,
+            Self.BACKFILL_PLACEMENT.placementKey: backfill,
+        ]))
+        return load(waterfall, coalescer: coalescer)
+    }
+    
+    private func load(_ waterfall: SASAdWaterfall, coalescer: SASAdLoadCoalescer) -> Result<(ad: SASCoalescedAd<SASBannerView>, stepIndex: Int), any Error> {
+        let loaded = expectation(description: "The waterfall has returned")
+        var loadResult: Result<(ad: SASCoalescedAd<SASBannerView>, stepIndex: Int), any Error>?
+        
+        let waterfallLoader = SASAdWaterfallLoader(waterfall: waterfall, coalescer: coalescer)
+        waterfallLoader.load { result in
+            loadResult = result
+            loaded.fulfill()
+        }
+        
+        wait(for: [loaded], timeout: 2.0)
+        return loadResult ?? .failure(CancellationError())
+    }
+    
+    private static func loadingError(of result: Result<(ad: SASCoalescedAd<SASBannerView>, stepIndex: Int), any Error>) -> SASAdWaterfall.LoadingError? {
+        guard case .failure(let error) = result else { return nil }
+        return error as? SASAdWaterfall.LoadingError
+    }
+    
+}
+
+/**
+ Loader performing the ad calls of each placement with its own ad server simulator.
+ */
+private final class SASAdPlacementLoader: SASAdLoader {
+    
+    private let servers: [SASAdPlacementKey: SASAdServerSimulator]
+    
+    init(servers: [SASAdPlacementKey: SASAdServerSimulator]) {
+        self.servers = servers
+    }
+    
+    func loadBannerView(with adPlacement: SASAdPlacement, completion: @escaping BannerCompletion) -> SASAdCall {
+        return servers[adPlacement.placementKey]!.loadBannerView(with: adPlacement, completion: completion)
+    }
+    
+    func loadInterstitial(with adPlacement: SASAdPlacement, completion: @escaping InterstitialCompletion) -> SASAdCall {
+        return servers[adPlacement.placementKey]!.loadInterstitial(with: adPlacement, completion: completion)
+    }
+    
+}
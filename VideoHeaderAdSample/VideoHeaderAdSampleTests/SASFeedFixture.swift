@@ -0,0 +1,130 @@
+//
+//  SASFeedFixture.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import UIKit
+@testable import VideoHeaderAdSample
+
+/**
+ A feed of self-sizing rows of variable heights, displayed in an on-screen table view and headed by a video header
+ ad cell, used to measure the layout work of the ad cell in a realistic table view.
+ */
+final class SASFeedFixture: NSObject, UITableViewDataSource {
+    
+    // MARK: - Feed cell
+    
+    /// Content cell of the feed, whose height depends on the length of its text.
+    final class FeedCell: UITableViewCell {
+        
+        static let REUSE_IDENTIFIER = "FeedCell"
+        
+        /// Number of times a feed cell has been measured by its table view (reset by the benchmarks).
+        static var measurementCount = 0
+        
+        let label = UILabel()
+        
+        override init(style: UITableViewCell.CellStyle, reuseIdentifier: String?) {
+            super.init(style: style, reuseIdentifier: reuseIdentifier)
+            
+            label.numberOfLines = 0
+            label.translatesAutoresizingMaskIntoConstraints = false
+            contentView.addSubview(label)
+            NSLayoutConstraint.activate([
+                label.leadingAnchor.constraint(equalTo: contentView.layoutMarginsGuide.leadingAnchor),
+                label.trailingAnchor.constraint(equalTo: contentView.layoutMarginsGuide.trailingAnchor),
+                label.topAnchor.constraint(equalTo: contentView.layoutMarginsGuide.topAnchor),
+                label.bottomAnchor.constraint(equalTo: contentView.layoutMarginsGuide.bottomAnchor),
+            ])
+        }
+        
+        required init?(coder: NSCoder) {
+            fatalError("init(coder:) has not been implemented")
+        }
+        
+        override func systemLayoutSizeFitting(_ targetSize: CGSize, withHorizontalFittingPriority horizontalFittingPriority: UILayoutPriority, verticalFittingPriority: UILayoutPriority) -> CGSize {
+            FeedCell.measurementCount += 1
+            return super.systemLayoutSizeFitting(targetSize, withHorizontalFittingPriority: horizontalFittingPriority, verticalFittingPriority: verticalFittingPriority)
+        }
+        
+    }
+    
+    // MARK: - Constants
+    
+    static let SCREEN_SIZE = CGSize(width: 390.0, height: 844.0)
+    
+    private static let ESTIMATED_ROW_HEIGHT: CGFloat = 88.0
+    private static let SENTENCE = "The quick brown fox jumps over the lazy dog. "
+    
+    // MARK: - Properties
+    
+    let window: UIWindow
+    let tableView: UITableView
+    let adCell: SASVideoHeaderAdCell
+    
+    /// Number of content rows of the feed (the ad cell excluded).
+    let rowCount: Int
+    
+    // MARK: - Initialization
+    
+    /**
+     Initialize a new feed, laid out on screen with its ad cell expanded to the maximum size of the ad.
+     
+     @param rowCount The number of content rows of the feed.
+     @param selfSizingInvalidation The self-sizing invalidation mode of the table view.
+     @param configure A block configuring the ad cell before it is displayed.
+     */
+    init(rowCount: Int, selfSizingInvalidation: UITableView.SelfSizingInvalidation = .enabled, configure: (SASVideoHeaderAdCell) -> Void = { _ in }) {
+        self.rowCount = rowCount
+        
+        let scene = UIApplication.shared.connectedScenes.compactMap { $0 as? UIWindowScene }.first
+        window = scene.map(UIWindow.init(windowScene:)) ?? UIWindow()
+        window.frame = CGRect(origin: .zero, size: SASFeedFixture.SCREEN_SIZE)
+        
+        tableView = UITableView(frame: window.bounds, style: .plain)
+        tableView.rowHeight = UITableView.automaticDimension
+        tableView.estimatedRowHeight = SASFeedFixture.ESTIMATED_ROW_HEIGHT
+        tableView.selfSizingInvalidation = selfSizingInvalidation
+        tableView.register(FeedCell.self, forCellReuseIdentifier: FeedCell.REUSE_IDENTIFIER)
+        
+        // The ad cell is instantiated from its nib, like in the sample, without loading any ad.
+        let nib = UINib(nibName: SASVideoHeaderAdCell.NIB_NAME, bundle: Bundle(for: SASVideoHeaderAdCell.self))
+        adCell = nib.instantiate(withOwner: nil).compactMap { $0 as? SASVideoHeaderAdCell }.first!
+        adCell.prefetchCache = nil
+        adCell.loadCoalescer = nil
+        adCell.retryPolicy = nil
+        
+        super.init()
+        
+        configure(adCell)
+        adCell.frame.size.width = SASFeedFixture.SCREEN_SIZE.width
+        adCell.scrollViewDidScroll(offset: .zero)
+        
+        tableView.dataSource = self
+        window.addSubview(tableView)
+        window.isHidden = false
+        tableView.layoutIfNeeded()
+    }
+    
+    deinit {
+        window.isHidden = true
+    }
+    
+    // MARK: - Table view data source
+    
+    func tableView(_ tableView: UITableView, numberOfRowsInSection section: Int) -> Int {
+        return rowCount + 1
+    }
+    
+    func tableView(_ tableView: UITableView, cellForRowAt indexPath: IndexPath) -> UITableViewCell {
+        guard indexPath.row > 0 else { return adCell }
+        
+        // Rows have between 1 and 9 sentences, so their heights vary along the feed.
+        let cell = tableView.dequeueReusableCell(withIdentifier: FeedCell.REUSE_IDENTIFIER, for: indexPath) as! FeedCell
+        cell.label.text = String(repeating: SASFeedFixture.SENTENCE, count: 1 + (indexPath.row * 7) % 9)
+        return cell
+    }
+    
+}
@@ -0,0 +1,126 @@
+//
+//  SASKeywordTargetingBenchmarks.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import XCTest
+import SASDisplayKit
+@testable import VideoHeaderAdSample
+
+/**
+ Throughput benchmark of the keyword targeting compiler: screens displayed per second when building the keyword
+ string of their placement, from a full concatenation on each screen to the reuse of a precompiled targeting.
+ */
+final class SASKeywordTargetingBenchmarks: XCTestCase {
+    
+    // MARK: - Constants
+    
+    /// Number of pairs of the targeting, like the dozens of pairs built on every screen.
+    private static let PAIR_COUNT = 50
+    
+    /// Number of screens displayed by each scenario.
+    private static let SCREEN_COUNT = 10_000
+    
+    /// Characters that must be escaped in keys and values, like the compiler does.
+    private static let ALLOWED_CHARACTERS = CharacterSet(charactersIn: ";=%").inverted
+    
+    // MARK: - Benchmarks
+    
+    func testThroughput() {
+        let pairs = (0..<Self.PAIR_COUNT).map { ("key\($0)", "value \($0);=%") }
+        
+        // Full concatenation of the whole string on each screen, one pair changing per screen.
+        var fullPairs = pairs
+        var fullString = ""
+        let fullDuration = Self.duration {
+            for screen in 0..<Self.SCREEN_COUNT {
+                fullPairs[screen % Self.PAIR_COUNT].1 = "screen \(screen)"
+                fullString = Self.concatenate(fullPairs)
+            }
+        }
+        
+        // Incremental rebuild: only the changed pair is encoded again.
+        var targeting = Self.targeting(of: pairs)
+        _ = targeting.compile()
+        var incrementalString = ""
+        let incrementalDuration = Self.duration {
+            for screen in 0..<Self.SCREEN_COUNT {
+                targeting.setValue("screen \(screen)", forKey: pairs[screen % Self.PAIR_COUNT].0)
+                incrementalString = targeting.compile().string
+            }
+        }
+        let incrementalCounters = targeting.counters
+        
+        // Unchanged targeting: every compilation is served from the cache.
+        var cachedTargeting = Self.targeting(of: pairs)
+        let cachedDuration = Self.duration {
+            for _ in 0..<Self.SCREEN_COUNT {
+                _ = cachedTargeting.compile()
+            }
+        }
+        
+        // Precompiled targeting reused to create the placements of every screen.
+        let compiled = Self.targeting(of: pairs).compile()
+        let precompiledDuration = Self.duration {
+            for _ in 0..<Self.SCREEN_COUNT {
+                _ = compiled.adPlacement(siteId: 507206, pageId: 1579908, formatId: 15048)
+            }
+        }
+        let placementDuration = Self.duration {
+            for _ in 0..<Self.SCREEN_COUNT {
+                _ = SASAdPlacement(siteId: 507206, pageId: 1579908, formatId: 15048, keywordTargeting: Self.concatenate(pairs))
+            }
+        }
+        
+        print("[benchmark] keyword targeting (\(Self.PAIR_COUNT) pairs, \(Self.SCREEN_COUNT) screens): \(Self.screensPerSecond(incrementalDuration)) screens/s incremental vs \(Self.screensPerSecond(fullDuration)) screens/s full concatenation, \(Self.screensPerSecond(cachedDuration)) screens/s cached — placements \(Self.screensPerSecond(precompiledDuration)) /s precompiled vs \(Self.screensPerSecond(placementDuration)) /s concatenated")
+        
+        // Both builds produce the same string, the incremental one encoding a single pair per screen.
+        XCTAssertEqual(incrementalString, fullString)
+        XCTAssertEqual(incrementalCounters.encodedPairs, Self.PAIR_COUNT + Self.SCREEN_COUNT)
+        XCTAssertEqual(cachedTargeting.counters.cachedCompilations, Self.SCREEN_COUNT - 1)
+    }
+    
+    func testIncrementalRebuild() {
+        let pairs = (0..<Self.PAIR_COUNT).map { ("key\($0)", "value \($0);=%") }
+        var targeting = Self.targeting(of: pairs)
+        
+        measure(metrics: [XCTClockMetric()]) {
+            for screen in 0..<Self.SCREEN_COUNT {
+                targeting.setValue("screen \(screen)", forKey: pairs[screen % Self.PAIR_COUNT].0)
+                _ = targeting.compile()
+            }
+        }
+    }
+    
+    // MARK: - Private methods
+    
+    private static func targeting(of pairs: [(String, String)]) -> SASKeywordTargeting {
+        var targeting = SASKeywordTargeting()
+        for (key, value) in pairs {
+            targeting.setValue(value, forKey: key)
+        }
+        return targeting
+    }
+    
+    /// Builds the whole keyword string, like before the keyword targeting compiler.
+    private static func concatenate(_ pairs: [(String, String)]) -> String {
+        return pairs.map { key, value in
+            let encodedKey = key.addingPercentEncoding(withAllowedCharacters: ALLOWED_CHARACTERS) ?? key
+            let encodedValue = value.addingPercentEncoding(withAllowedCharacters: ALLOWED_CHARACTERS) ?? value
+            return encodedKey + "=" + encodedValue
+        }.joined(separator: ";")
+    }
+    
+    private static func duration(of block: () -> Void) -> TimeInterval {
+        let start = DispatchTime.now().uptimeNanoseconds
+        block()
+        return TimeInterval(DispatchTime.now().uptimeNanoseconds - start) / 1_000_000_000.0
+    }
+    
+    private static func screensPerSecond(_ duration: TimeInterval) -> Int {
+        return Int(Double(SCREEN_COUNT) / duration)
+    }
+    
+}
@@ -0,0 +1,70 @@
+//
+//  SASKeywordTargetingTests.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import XCTest
+import SASDisplayKit
+@testable import VideoHeaderAdSample
+
+/**
+ Tests of the compilation of the keyword targeting, and of its incremental rebuild.
+ */
+final class SASKeywordTargetingTests: XCTestCase {
+    
+    // MARK: - Tests
+    
+    func testPairsAreCompiledInInsertionOrder() {
+        var targeting = SASKeywordTargeting(["header01": nil, "section": "sport", "tags": "a;b=c%"])
+        
+        XCTAssertEqual(targeting.compile().string, "header01;section=sport;tags=a%3Bb%3Dc%25")
+        XCTAssertEqual(targeting.allKeys, ["header01", "section", "tags"])
+    }
+    
+    func testUnchangedTargetingIsServedFromCache() {
+        var targeting = SASKeywordTargeting(["section": "sport", "page": "home"])
+        
+        let compiled = targeting.compile()
+        targeting.setValue("sport", forKey: "section")
+        
+        XCTAssertEqual(targeting.compile(), compiled)
+        XCTAssertEqual(targeting.counters, SASKeywordTargeting.Counters(compilations: 2, cachedCompilations: 1, encodedPairs: 2))
+    }
+    
+    func testOnlyChangedPairsAreEncodedAgain() {
+        var targeting = SASKeywordTargeting(["section": "sport", "page": "home", "position": "1"])
+        _ = targeting.compile()
+        
+        targeting.setValue("2", forKey: "position")
+        targeting.setValue("news", forKey: "category")
+        
+        XCTAssertEqual(targeting.compile().string, "section=sport;page=home;position=2;category=news")
+        XCTAssertEqual(targeting.counters.encodedPairs, 5)
+    }
+    
+    func testRemovedKeyIsNotCompiled() {
+        var targeting = SASKeywordTargeting(["section": "sport", "page": "home"])
+        _ = targeting.compile()
+        
+        targeting.removeValue(forKey: "section")
+        
+        XCTAssertEqual(targeting.compile().string, "page=home")
+        XCTAssertNil(targeting.value(forKey: "section"))
+        XCTAssertEqual(targeting.counters.encodedPairs, 2)
+    }
+    
+    func testCompiledTargetingIsReusedAcrossPlacements() {
+        var targeting = SASKeywordTargeting(["header01": nil])
+        let compiled = targeting.compile()
+        
+        let adPlacement = compiled.adPlacement(siteId: 507206, pageId: 1579908, formatId: 15048)
+        let otherAdPlacement = compiled.adPlacement(siteId: 507206, pageId: 1579908, formatId: 15140)
+        
+        XCTAssertEqual(adPlacement.keywordTargeting, "header01")
+        XCTAssertEqual(otherAdPlacement.keywordTargeting, "header01")
+        XCTAssertNil(SASKeywordTargeting().compile().adPlacement(siteId: 507206, pageId: 1579908, formatId: 15048).keywordTargeting)
+    }
+    
+}
@@ -0,0 +1,98 @@
+//
+//  SASSellerDefinedCodecBenchmarks.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import XCTest
+import SASDisplayKit
+@testable import VideoHeaderAdSample
+
+/**
+ Benchmark of the seller-defined binary codec against `NSKeyedArchiver`: archive size, encoding and decoding times.
+ */
+final class SASSellerDefinedCodecBenchmarks: XCTestCase {
+    
+    // MARK: - Constants
+    
+    private static let SEGMENT_COUNTS = [10, 1_000, 100_000]
+    
+    /// Number of runs of each encoding and decoding, whose fastest run is reported.
+    private static let RUN_COUNT = 5
+    
+    // MARK: - Benchmarks
+    
+    func testCodecAgainstKeyedArchiver() throws {
+        for segmentCount in Self.SEGMENT_COUNTS {
+            let archive = SASSellerDefinedCodec.Archive(
+                audiences: SASSellerDefinedFixture.audiences(segmentCount: segmentCount / 2),
+                contents: SASSellerDefinedFixture.contents(segmentCount: segmentCount - segmentCount / 2)
+            )
+            
+            var data = Data()
+            let encodingDuration = Self.fastestRun { data = SASSellerDefinedCodec.encode(archive) }
+            let decodingDuration = try Self.fastestRun { _ = try SASSellerDefinedCodec.decode(data) }
+            
+            var archivedData = Data()
+            let archivingDuration = try Self.fastestRun { archivedData = try Self.archive(archive) }
+            let unarchivingDuration = try Self.fastestRun { _ = try Self.unarchive(archivedData) }
+            
+            print("[benchmark] seller-defined codec (\(segmentCount) segments): \(data.count) bytes vs \(archivedData.count) bytes archived — encoded in \(Self.milliseconds(encodingDuration)) ms vs \(Self.milliseconds(archivingDuration)) ms, decoded in \(Self.milliseconds(decodingDuration)) ms vs \(Self.milliseconds(unarchivingDuration)) ms")
+            
+            // Both formats must hold the same values, the codec storing them in fewer bytes.
+            XCTAssertEqual(try SASSellerDefinedCodec.decode(data).audiences.count, try Self.unarchive(archivedData).audiences.count)
+            XCTAssertLessThan(data.count, archivedData.count)
+        }
+    }
+    
+    func testDecodingOfMappedFileWithHundredThousandSegments() throws {
+        let archive = SASSellerDefinedCodec.Archive(
+            audiences: SASSellerDefinedFixture.audiences(segmentCount: 50_000),
+            contents: SASSellerDefinedFixture.contents(segmentCount: 50_000)
+        )
+        let url = FileManager.default.temporaryDirectory.appendingPathComponent("\(UUID().uuidString).sasd")
+        try SASSellerDefinedCodec.encode(archive).write(to: url)
+        defer { try? FileManager.default.removeItem(at: url) }
+        
+        let options = XCTMeasureOptions()
+        options.invocationOptions = [.manuallyStart, .manuallyStop]
+        measure(metrics: [XCTClockMetric(), XCTMemoryMetric()], options: options) {
+            startMeasuring()
+            _ = try? SASSellerDefinedCodec.decode(contentsOf: url)
+            stopMeasuring()
+        }
+    }
+    
+    // MARK: - Private methods
+    
+    /// Archives the audiences and contents with `NSKeyedArchiver` (their classes only conform to `NSCoding`).
+    private static func archive(_ archive: SASSellerDefinedCodec.Archive) throws -> Data {
+        return try NSKeyedArchiver.archivedData(withRootObject: [archive.audiences, archive.contents] as NSArray, requiringSecureCoding: false)
+    }
+    
+    private static func unarchive(_ data: Data) throws -> SASSellerDefinedCodec.Archive {
+        let unarchiver = try NSKeyedUnarchiver(forReadingFrom: data)
+        unarchiver.requiresSecureCoding = false
+        let root = unarchiver.decodeObject(forKey: NSKeyedArchiveRootObjectKey) as? [Any]
+        return SASSellerDefinedCodec.Archive(
+            audiences: root?.first as? [SASSellerDefinedAudience] ?? [],
+            contents: root?.last as? [SASSellerDefinedContent] ?? []
+        )
+    }
+    
+    private static func fastestRun(_ block: () throws -> Void) rethrows -> TimeInterval {
+        var fastestDuration = TimeInterval.infinity
+        for _ in 0..<RUN_COUNT {
+            let start = DispatchTime.now().uptimeNanoseconds
+            try block()
+            fastestDuration = min(fastestDuration, TimeInterval(DispatchTime.now().uptimeNanoseconds - start) / 1_000_000_000.0)
+        }
+        return fastestDuration
+    }
+    
+    private static func milliseconds(_ duration: TimeInterval) -> String {
+        return String(format: "%.2f", duration * 1_000.0)
+    }
+    
+}
@@ -0,0 +1,140 @@
+//
+//  SASSellerDefinedCodecTests.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import XCTest
+import SASDisplayKit
+@testable import VideoHeaderAdSample
+
+/**
+ Tests of the round trip and of the validation of the seller-defined binary codec.
+ */
+final class SASSellerDefinedCodecTests: XCTestCase {
+    
+    // MARK: - Constants
+    
+    private static let SEGMENT_COUNT = 1_000
+    
+    // MARK: - Tests
+    
+    func testArchiveRoundTrips() throws {
+        let archive = SASSellerDefinedCodec.Archive(
+            audiences: SASSellerDefinedFixture.audiences(segmentCount: Self.SEGMENT_COUNT),
+            contents: SASSellerDefinedFixture.contents(segmentCount: Self.SEGMENT_COUNT)
+        )
+        
+        let decodedArchive = try SASSellerDefinedCodec.decode(SASSellerDefinedCodec.encode(archive))
+        
+        XCTAssertEqual(Self.placementKey(of: decodedArchive), Self.placementKey(of: archive))
+    }
+    
+    func testMissingAndEmptyValuesRoundTrip() throws {
+        let archive = SASSellerDefinedCodec.Archive(
+            audiences: [
+                SASSellerDefinedAudience(id: nil, name: nil, segments: nil),
+                SASSellerDefinedAudience(id: "", name: "", segments: []),
+            ],
+            contents: [
+                SASSellerDefinedContent(id: "content", name: "Éditeur 📺", segments: [
+                    SASSellerDefinedSegment(id: nil, name: "genre", value: nil),
+                    SASSellerDefinedSegment(id: "1", name: nil, value: "drame"),
+                ]),
+            ]
+        )
+        
+        let decodedArchive = try SASSellerDefinedCodec.decode(SASSellerDefinedCodec.encode(archive))
+        
+        XCTAssertEqual(Self.placementKey(of: decodedArchive), Self.placementKey(of: archive))
+        XCTAssertNil(decodedArchive.audiences[0].segments)
+        XCTAssertEqual(decodedArchive.audiences[1].segments?.count, 0)
+        XCTAssertEqual(decodedArchive.contents[0].name, "Éditeur 📺")
+    }
+    
+    func testEmptyArchiveRoundTrips() throws {
+        let decodedArchive = try SASSellerDefinedCodec.decode(SASSellerDefinedCodec.encode(SASSellerDefinedCodec.Archive(audiences: [], contents: [])))
+        
+        XCTAssertTrue(decodedArchive.audiences.isEmpty)
+        XCTAssertTrue(decodedArchive.contents.isEmpty)
+    }
+    
+    func testArchiveIsDecodedFromMappedFile() throws {
+        let archive = SASSellerDefinedCodec.Archive(
+            audiences: SASSellerDefinedFixture.audiences(segmentCount: Self.SEGMENT_COUNT),
+            contents: []
+        )
+        let url = FileManager.default.temporaryDirectory.appendingPathComponent("\(UUID().uuidString).sasd")
+        try SASSellerDefinedCodec.encode(archive).write(to: url)
+        defer { try? FileManager.default.removeItem(at: url) }
+        
+        let decodedArchive = try SASSellerDefinedCodec.decode(contentsOf: url)
+        
+        XCTAssertEqual(Self.placementKey(of: decodedArchive), Self.placementKey(of: archive))
+    }
+    
+    func testStringsAreStoredOnce() {
+        // 1000 segments built from a few hundred distinct strings.
+        let archive = SASSellerDefinedCodec.Archive(audiences: SASSellerDefinedFixture.audiences(segmentCount: Self.SEGMENT_COUNT), contents: [])
+        let repeatedArchive = SASSellerDefinedCodec.Archive(audiences: archive.audiences + archive.audiences, contents: [])
+        
+        let size = SASSellerDefinedCodec.encode(archive).count
+        let repeatedSize = SASSellerDefinedCodec.encode(repeatedArchive).count
+        
+        // The repeated audiences only add their references, not their strings.
+        XCTAssertLessThan(repeatedSize, 2 * size)
+    }
+    
+    func testInvalidHeaderIsRejected() {
+        XCTAssertThrowsError(try SASSellerDefinedCodec.decode(Data("SASX".utf8) + [SASSellerDefinedCodec.VERSION, 0, 0, 0])) { error in
+            guard case SASSellerDefinedCodec.DecodingError.invalidHeader = error else {
+                return XCTFail("Unexpected error \(error)")
+            }
+        }
+        XCTAssertThrowsError(try SASSellerDefinedCodec.decode(Data("SAS".utf8))) { error in
+            guard case SASSellerDefinedCodec.DecodingError.invalidHeader = error else {
+                return XCTFail("Unexpected error \(error)")
+            }
+        }
+    }
+    
+    func testUnsupportedVersionIsRejected() {
+        XCTAssertThrowsError(try SASSellerDefinedCodec.decode(Data("SASD".utf8) + [SASSellerDefinedCodec.VERSION + 1, 0, 0, 0])) { error in
+            guard case SASSellerDefinedCodec.DecodingError.unsupportedVersion(SASSellerDefinedCodec.VERSION + 1) = error else {
+                return XCTFail("Unexpected error \(error)")
+            }
+        }
+    }
+    
+    func testInvalidStringReferenceIsRejected() {
+        // An empty string table, then one audience whose ID references the 5th string.
+        XCTAssertThrowsError(try SASSellerDefinedCodec.decode(Data("SASD".utf8) + [SASSellerDefinedCodec.VERSION, 0, 1, 5, 0, 0, 0])) { error in
+            guard case SASSellerDefinedCodec.DecodingError.invalidStringReference = error else {
+                return XCTFail("Unexpected error \(error)")
+            }
+        }
+    }
+    
+    func testEveryTruncationIsRejected() {
+        let data = SASSellerDefinedCodec.encode(SASSellerDefinedCodec.Archive(
+            audiences: SASSellerDefinedFixture.audiences(segmentCount: 20),
+            contents: SASSellerDefinedFixture.contents(segmentCount: 20)
+        ))
+        
+        for length in 0..<data.count {
+            XCTAssertThrowsError(try SASSellerDefinedCodec.decode(data.prefix(length)), "Truncated at \(length) bytes")
+        }
+    }
+    
+    // MARK: - Private methods
+    
+    /// Returns the key of a placement targeting the audiences and contents of the archive, which captures all their values.
+    private static func placementKey(of archive: SASSellerDefinedCodec.Archive) -> SASAdPlacementKey {
+        let adPlacement = SASAdPlacement(siteId: 507206, pageId: 1579908, formatId: 15048, keywordTargeting: nil)
+        adPlacement.sellerDefinedAudiences = archive.audiences
+        adPlacement.sellerDefinedContents = archive.contents
+        return SASAdPlacementKey(adPlacement: adPlacement)
+    }
+    
+}
@@ -0,0 +1,133 @@
+//
+//  SASSellerDefinedFixture.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import Foundation
+import SASDisplayKit
+
+/**
+ Seller-defined audiences and contents shaped like the lists pushed by a data team: many segments, whose names and
+ values are taken from small vocabularies so they repeat across audiences and contents.
+ */
+enum SASSellerDefinedFixture {
+    
+    // MARK: - Constants
+    
+    /// Number of segments of each audience or content.
+    static let SEGMENTS_PER_ENTRY = 10
+    
+    private static let SEGMENT_NAMES = ["iab-category", "interest", "intent", "age-range", "gender", "income", "device", "region"]
+    
+    // MARK: - Fixtures
+    
+    /**
+     Returns segments built from the vocabularies.
+     
+     @param count The number of segments.
+     @param offset The index of the first segment, so different lists can be built.
+     @return The segments.
+     */
+    static func segments(count: Int, offset: Int = 0) -> [SASSellerDefinedSegment] {
+        return (offset..<offset + count).map { index in
+            SASSellerDefinedSegment(
+                id: "\(index % 500)",
+                name: SEGMENT_NAMES[index % SEGMENT_NAMES.count],
+                value: "value-\(index % 64)"
+            )
+        }
+    }
+    
+    /**
+     Returns audiences totalling the given number of segments.
+     
+     @param segmentCount The total number of segments of the audiences.
+     @return The audiences, with `SEGMENTS_PER_ENTRY` segments each (the last one possibly fewer).
+     */
+    static func audiences(segmentCount: Int) -> [SASSellerDefinedAudience] {
+        return stride(from: 0, to: segmentCount, by: SEGMENTS_PER_ENTRY).map { offset in
+            SASSellerDefinedAudience(
+                id: "audience-\(offset / SEGMENTS_PER_ENTRY % 100)",
+                name: "Audience provider",
+                segments: segments(count: min(SEGMENTS_PER_ENTRY, segmentCount - offset), offset: offset)
+            )
+        }
+    }
+    
+    /**
+     Returns contents totalling the given number of segments.
+     
+     @param segmentCount The total number of segments of the contents.
+     @return The contents, with `SEGMENTS_PER_ENTRY` segments each (the last one possibly fewer).
+     */
+    static func contents(segmentCount: Int) -> [SASSellerDefinedContent] {
+        return stride(from: 0, to: segmentCount, by: SEGMENTS_PER_ENTRY).map { offset in
+            SASSellerDefinedContent(
+                id: "content-\(offset / SEGMENTS_PER_ENTRY % 100)",
+                name: "Content provider",
+                segments: segments(count: min(SEGMENTS_PER_ENTRY, segmentCount - offset), offset: offset)
+            )
+        }
+    }
+    
+    /**
+     Returns a placement targeting audiences and contents totalling the given number of segments.
+     
+     @param segmentCount The total number of segments, shared equally between audiences and contents.
+     @param keywordTargeting The keyword targeting of the placement.
+     @return The placement.
+     */
+    static func adPlacement(segmentCount: Int, keywordTargeting: String? = nil) -> SASAdPlacement {
+        let adPlacement = SASAdPlacement(siteId: 507206, pageId: 1579908, formatId: 15048, keywordTargeting: keywordTargeting)
+        adPlacement.sellerDefinedAudiences = audiences(segmentCount: segmentCount / 2)
+        adPlacement.sellerDefinedContents = contents(segmentCount: segmentCount - segmentCount / 2)
+        return adPlacement
+    }
+    
+    /**
+     Returns a placement whose audiences and contents are all pushed twice, like when two data sources overlap.
+     
+     @param segmentCount The total number of distinct segments, shared equally between audiences and contents.
+     @return The placement, targeting twice as many segments.
+     */
+    static func duplicatedAdPlacement(segmentCount: Int) -> SASAdPlacement {
+        let adPlacement = Self.adPlacement(segmentCount: segmentCount)
+        adPlacement.sellerDefinedAudiences = adPlacement.sellerDefinedAudiences.map { $0 + $0 }
+        adPlacement.sellerDefinedContents = adPlacement.sellerDefinedContents.map { $0 + $0 }
+        return adPlacement
+    }
+    
+    // MARK: - Payload
+    
+    /**
+     Serializes the audiences and contents of a placement like the OpenRTB `user.data` and `site.content.data`
+     objects of an ad call, to measure the actual payload size.
+     
+     @param adPlacement The placement.
+     @return The JSON serialization of the audiences followed by the contents.
+     */
+    static func jsonPayload(of adPlacement: SASAdPlacement) -> Data {
+        let audiences = (adPlacement.sellerDefinedAudiences ?? []).map { dataObject(id: $0.id, name: $0.name, segments: $0.segments) }
+        let contents = (adPlacement.sellerDefinedContents ?? []).map { dataObject(id: $0.id, name: $0.name, segments: $0.segments) }
+        let audiencesPayload = (try? JSONSerialization.data(withJSONObject: audiences)) ?? Data()
+        let contentsPayload = (try? JSONSerialization.data(withJSONObject: contents)) ?? Data()
+        return audiencesPayload + contentsPayload
+    }
+    
+    private static func dataObject(id: String?, name: String?, segments: [SASSellerDefinedSegment]?) -> [String: Any] {
+        var object = [String: Any]()
+        object["id"] = id
+        object["name"] = name
+        object["segment"] = segments?.map { segment -> [String: Any] in
+            var segmentObject = [String: Any]()
+            segmentObject["id"] = segment.id
+            segmentObject["name"] = segment.name
+            segmentObject["value"] = segment.value
+            return segmentObject
+        }
+        return object
+    }
+    
+}
@@ -0,0 +1,76 @@
+//
+//  SASSellerDefinedTargetingCompactorBenchmarks.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import XCTest
+import SASDisplayKit
+@testable import VideoHeaderAdSample
+
+/**
+ Offline request-builder benchmark of the seller-defined targeting compactor: bytes saved per ad call and build time,
+ against the time to serialize the audiences and contents of the request.
+ */
+final class SASSellerDefinedTargetingCompactorBenchmarks: XCTestCase {
+    
+    // MARK: - Constants
+    
+    private static let SEGMENT_COUNTS = [1_000, 10_000, 100_000]
+    
+    /// Payload size budget of the bounded compaction.
+    private static let MAXIMUM_PAYLOAD_SIZE = 64 * 1_024
+    
+    // MARK: - Benchmarks
+    
+    func testBytesSavedAndBuildTime() {
+        for segmentCount in Self.SEGMENT_COUNTS {
+            for maximumPayloadSize in [nil, Self.MAXIMUM_PAYLOAD_SIZE] {
+                let adPlacement = SASSellerDefinedFixture.duplicatedAdPlacement(segmentCount: segmentCount)
+                let (originalPayload, originalSerializationDuration) = Self.buildPayload(of: adPlacement)
+                
+                var compactor = SASSellerDefinedTargetingCompactor()
+                compactor.maximumPayloadSize = maximumPayloadSize
+                let report = compactor.apply(to: adPlacement)
+                let (compactedPayload, compactedSerializationDuration) = Self.buildPayload(of: adPlacement)
+                
+                let budget = maximumPayloadSize.map { "\($0 / 1_024) kB budget" } ?? "no budget"
+                print("[benchmark] targeting compaction (\(segmentCount) segments, \(budget)): \(originalPayload.count - compactedPayload.count) bytes saved (\(report.bytesSaved) estimated), \(originalPayload.count) → \(compactedPayload.count) bytes — built in \(Self.milliseconds(report.buildDuration)) ms, serialized in \(Self.milliseconds(compactedSerializationDuration)) ms vs \(Self.milliseconds(originalSerializationDuration)) ms")
+                
+                // Half of the payload is duplicated: the compaction must save at least a third of it.
+                XCTAssertGreaterThan(report.bytesSaved, report.originalSize / 3)
+                XCTAssertLessThan(compactedPayload.count, originalPayload.count)
+                if let maximumPayloadSize {
+                    XCTAssertLessThanOrEqual(compactedPayload.count, maximumPayloadSize)
+                }
+            }
+        }
+    }
+    
+    func testBuildTimeWithTenThousandSegments() {
+        let options = XCTMeasureOptions()
+        options.invocationOptions = [.manuallyStart, .manuallyStop]
+        measure(metrics: [XCTClockMetric()], options: options) {
+            let adPlacement = SASSellerDefinedFixture.duplicatedAdPlacement(segmentCount: 10_000)
+            
+            startMeasuring()
+            SASSellerDefinedTargetingCompactor().apply(to: adPlacement)
+            stopMeasuring()
+        }
+    }
+    
+    // MARK: - Private methods
+    
+    /// Serializes the audiences and contents of the placement like the request builder does, returning the duration.
+    private static func buildPayload(of adPlacement: SASAdPlacement) -> (Data, TimeInterval) {
+        let start = DispatchTime.now().uptimeNanoseconds
+        let payload = SASSellerDefinedFixture.jsonPayload(of: adPlacement)
+        return (payload, TimeInterval(DispatchTime.now().uptimeNanoseconds - start) / 1_000_000_000.0)
+    }
+    
+    private static func milliseconds(_ duration: TimeInterval) -> String {
+        return String(format: "%.2f", duration * 1_000.0)
+    }
+    
+}
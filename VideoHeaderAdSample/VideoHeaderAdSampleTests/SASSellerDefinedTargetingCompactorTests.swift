@@ -0,0 +1,85 @@
+//
+//  SASSellerDefinedTargetingCompactorTests.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import XCTest
+import SASDisplayKit
+@testable import VideoHeaderAdSample
+
+/**
+ Tests of the compaction of the seller-defined audiences and contents of a placement, and of its report.
+ */
+final class SASSellerDefinedTargetingCompactorTests: XCTestCase {
+    
+    // MARK: - Constants
+    
+    private static let SEGMENT_COUNT = 1_000
+    
+    // MARK: - Tests
+    
+    func testDuplicatedEntriesAndSegmentsAreRemoved() {
+        let adPlacement = SASSellerDefinedFixture.duplicatedAdPlacement(segmentCount: Self.SEGMENT_COUNT)
+        let key = adPlacement.placementKey
+        
+        let report = SASSellerDefinedTargetingCompactor().apply(to: adPlacement)
+        
+        // Every entry is pushed twice: the second one is merged into the first one, and all its segments removed.
+        let entryCount = Self.SEGMENT_COUNT / SASSellerDefinedFixture.SEGMENTS_PER_ENTRY
+        XCTAssertEqual(report.mergedEntries, entryCount)
+        XCTAssertEqual(report.removedDuplicateSegments, Self.SEGMENT_COUNT)
+        XCTAssertEqual(report.droppedSegments, 0)
+        XCTAssertEqual(adPlacement.sellerDefinedAudiences?.count, entryCount / 2)
+        XCTAssertEqual(adPlacement.sellerDefinedContents?.count, entryCount / 2)
+        
+        // The compacted placement targets the same segments as the original lists, with a new key.
+        XCTAssertEqual(adPlacement.placementKey, SASSellerDefinedFixture.adPlacement(segmentCount: Self.SEGMENT_COUNT).placementKey)
+        XCTAssertNotEqual(adPlacement.placementKey, key)
+    }
+    
+    func testReportedBytesSavedMatchThePayload() {
+        let adPlacement = SASSellerDefinedFixture.duplicatedAdPlacement(segmentCount: Self.SEGMENT_COUNT)
+        let originalPayloadSize = SASSellerDefinedFixture.jsonPayload(of: adPlacement).count
+        
+        let report = SASSellerDefinedTargetingCompactor().apply(to: adPlacement)
+        let compactedPayloadSize = SASSellerDefinedFixture.jsonPayload(of: adPlacement).count
+        
+        // The sizes are estimated without serializing the payload: they must stay within 5% of the actual sizes.
+        XCTAssertEqual(Double(report.originalSize), Double(originalPayloadSize), accuracy: Double(originalPayloadSize) * 0.05)
+        XCTAssertEqual(Double(report.compactedSize), Double(compactedPayloadSize), accuracy: Double(compactedPayloadSize) * 0.05)
+        XCTAssertEqual(Double(report.bytesSaved), Double(originalPayloadSize - compactedPayloadSize), accuracy: Double(originalPayloadSize - compactedPayloadSize) * 0.05)
+        XCTAssertGreaterThan(report.buildDuration, 0.0)
+    }
+    
+    func testPayloadIsBoundedBySizeBudget() {
+        let adPlacement = SASSellerDefinedFixture.adPlacement(segmentCount: Self.SEGMENT_COUNT)
+        let firstSegment = adPlacement.sellerDefinedAudiences?.first?.segments?.first
+        var compactor = SASSellerDefinedTargetingCompactor()
+        compactor.maximumPayloadSize = 8_192
+        
+        let report = compactor.apply(to: adPlacement)
+        
+        XCTAssertLessThanOrEqual(report.compactedSize, 8_192)
+        XCTAssertLessThanOrEqual(SASSellerDefinedFixture.jsonPayload(of: adPlacement).count, 8_192)
+        XCTAssertGreaterThan(report.droppedSegments, 0)
+        
+        // The contents are dropped first, and the first segments are kept.
+        XCTAssertTrue(adPlacement.sellerDefinedContents?.allSatisfy { $0.segments?.isEmpty ?? true } ?? true)
+        XCTAssertEqual(adPlacement.sellerDefinedAudiences?.first?.segments?.first?.value, firstSegment?.value)
+    }
+    
+    func testCompactPlacementIsNotModified() {
+        let adPlacement = SASSellerDefinedFixture.adPlacement(segmentCount: Self.SEGMENT_COUNT)
+        let audiences = adPlacement.sellerDefinedAudiences
+        let key = adPlacement.placementKey
+        
+        let report = SASSellerDefinedTargetingCompactor().apply(to: adPlacement)
+        
+        XCTAssertEqual(report.bytesSaved, 0)
+        XCTAssertTrue(adPlacement.sellerDefinedAudiences?.first === audiences?.first)
+        XCTAssertEqual(adPlacement.placementKey, key)
+    }
+    
+}
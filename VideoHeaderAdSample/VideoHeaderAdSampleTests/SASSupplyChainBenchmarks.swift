@@ -0,0 +1,119 @@
+//
+//  SASSupplyChainBenchmarks.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import XCTest
+import SASDisplayKit
+@testable import VideoHeaderAdSample
+
+/**
+ Benchmark of the supply chain on deep chains: serialization into a reused buffer, single-pass validation and parsing,
+ against the assembly by hand of the string with Foundation percent-encoding.
+ */
+final class SASSupplyChainBenchmarks: XCTestCase {
+    
+    // MARK: - Constants
+    
+    private static let NODE_COUNTS = [1, 10, 100, 1_000]
+    
+    /// Number of runs per depth, like as many ad calls for resold inventory.
+    private static let RUN_COUNT = 100
+    
+    /// Characters left unescaped by the IAB string form.
+    private static let UNRESERVED_CHARACTERS = CharacterSet(charactersIn: "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789-._~")
+    
+    // MARK: - Benchmarks
+    
+    func testDeepChains() throws {
+        for nodeCount in Self.NODE_COUNTS {
+            let chain = Self.chain(nodeCount: nodeCount)
+            let string = chain.stringValue
+            
+            var buffer = [UInt8]()
+            let serializationDuration = Self.duration {
+                chain.serialize(into: &buffer)
+            }
+            let validationDuration = Self.duration {
+                _ = SASSupplyChain.validate(string)
+            }
+            let parsingDuration = Self.duration {
+                _ = try? SASSupplyChain(string: string)
+            }
+            var handmadeString = ""
+            let handmadeDuration = Self.duration {
+                handmadeString = Self.handmadeString(of: chain)
+            }
+            
+            print("[benchmark] supply chain (\(nodeCount) nodes, \(string.utf8.count) bytes): serialized in \(Self.microseconds(serializationDuration)) µs vs \(Self.microseconds(handmadeDuration)) µs by hand, validated in \(Self.microseconds(validationDuration)) µs, parsed in \(Self.microseconds(parsingDuration)) µs")
+            
+            XCTAssertEqual(String(decoding: buffer, as: UTF8.self), string)
+            XCTAssertEqual(handmadeString, string)
+            XCTAssertEqual(try SASSupplyChain(string: string), chain)
+        }
+    }
+    
+    func testValidationOfThousandNodeChain() {
+        let string = Self.chain(nodeCount: 1_000).stringValue
+        
+        measure(metrics: [XCTClockMetric()]) {
+            for _ in 0..<100 {
+                _ = SASSupplyChain.validate(string)
+            }
+        }
+    }
+    
+    func testSerializationOfThousandNodeChain() {
+        let chain = Self.chain(nodeCount: 1_000)
+        var buffer = [UInt8]()
+        
+        measure(metrics: [XCTClockMetric()]) {
+            for _ in 0..<100 {
+                chain.serialize(into: &buffer)
+            }
+        }
+    }
+    
+    // MARK: - Private methods
+    
+    /// Returns a chain of resellers, each node having every field, some of them to escape.
+    private static func chain(nodeCount: Int) -> SASSupplyChain {
+        return SASSupplyChain(isComplete: true, nodes: (0..<nodeCount).map { index in
+            SASSupplyChain.Node(
+                asi: "exchange\(index).com",
+                sid: "seller-\(index)",
+                hp: index % 2 == 0,
+                rid: "request-\(index)",
+                name: "Reseller \(index), Inc.",
+                domain: "reseller\(index).com",
+                ext: "{\"tier\":\(index % 3)}"
+            )
+        })
+    }
+    
+    /// Assembles the string by hand, re-escaping every field like before the typed supply chain.
+    private static func handmadeString(of chain: SASSupplyChain) -> String {
+        let nodes = chain.nodes.map { node in
+            [node.asi, node.sid, node.hp ? "1" : "0", node.rid ?? "", node.name ?? "", node.domain ?? "", node.ext ?? ""]
+                .map { $0.addingPercentEncoding(withAllowedCharacters: UNRESERVED_CHARACTERS) ?? "" }
+                .joined(separator: ",")
+        }
+        return (["\(SASSupplyChain.VERSION),\(chain.isComplete ? "1" : "0")"] + nodes).joined(separator: "!")
+    }
+    
+    /// Returns the mean duration of a run.
+    private static func duration(of block: () -> Void) -> TimeInterval {
+        let start = DispatchTime.now().uptimeNanoseconds
+        for _ in 0..<RUN_COUNT {
+            block()
+        }
+        return TimeInterval(DispatchTime.now().uptimeNanoseconds - start) / 1_000_000_000.0 / Double(RUN_COUNT)
+    }
+    
+    private static func microseconds(_ duration: TimeInterval) -> String {
+        return String(format: "%.2f", duration * 1_000_000.0)
+    }
+    
+}
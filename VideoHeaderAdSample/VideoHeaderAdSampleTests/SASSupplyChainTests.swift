@@ -0,0 +1,223 @@
+//
+//  SASSupplyChainTests.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import XCTest
+import SASDisplayKit
+@testable import VideoHeaderAdSample
+
+/**
+ Tests of the supply chain serialization, parsing and validation, including a fuzz test of malformed strings.
+ 
+ The fuzz test checks the single-pass validator against a straightforward reference implementation, splitting the
+ string then decoding each field with the UTF-8 decoder of the standard library: both must accept and reject the
+ same strings, and the parser must return the fields decoded by the reference.
+ */
+final class SASSupplyChainTests: XCTestCase {
+    
+    // MARK: - Constants
+    
+    /// Number of random chains and of mutated strings of the fuzz tests.
+    private static let FUZZ_CASE_COUNT = 20_000
+    
+    /// Pieces inserted by the mutations: separators, broken or valid escapes, and invalid UTF-8 once decoded.
+    private static let MUTATION_TOKENS = [
+        ",", "!", "%", "%F", "%FF", "%ff", "%G1", "%2C", "%21", "%25", "%41", "%C3%A9", "%e2%82%ac", "%E2%82",
+        "%C0%80", "%ED%A0%80", "%F4%90%80%80", "%F0%9F%99%82", "%80", "0", "1", "2", "a", "é", "🙂", " ", "\u{0}",
+    ]
+    
+    /// Characters of the random field values, reserved ones included so they must be escaped.
+    private static let FIELD_CHARACTERS = Array("abcXYZ019-._~ ,!%&=+/?#é€🙂\u{0}")
+    
+    // MARK: - Tests
+    
+    func testChainRoundTrips() throws {
+        let chain = SASSupplyChain(isComplete: true, nodes: [
+            SASSupplyChain.Node(asi: "exchange1.com", sid: "1234", hp: true, rid: "bid-request-1", name: "Publisher, Inc.", domain: "publisher.com"),
+            SASSupplyChain.Node(asi: "exchange2.com", sid: "abcd", hp: false, ext: "{\"a\":1}"),
+        ])
+        
+        XCTAssertEqual(chain.stringValue, "1.0,1!exchange1.com,1234,1,bid-request-1,Publisher%2C%20Inc.,publisher.com!exchange2.com,abcd,0,,,,%7B%22a%22%3A1%7D")
+        XCTAssertEqual(try SASSupplyChain(string: chain.stringValue), chain)
+    }
+    
+    func testBufferIsReused() {
+        let chain = SASSupplyChain(isComplete: false, nodes: [SASSupplyChain.Node(asi: "exchange1.com", sid: "1234")])
+        var buffer = [UInt8]()
+        
+        chain.serialize(into: &buffer)
+        let capacity = buffer.capacity
+        chain.serialize(into: &buffer)
+        
+        XCTAssertEqual(String(decoding: buffer, as: UTF8.self), "1.0,0!exchange1.com,1234,1")
+        XCTAssertEqual(buffer.capacity, capacity)
+    }
+    
+    func testMalformedStringsAreRejected() {
+        XCTAssertEqual(SASSupplyChain.validate(""), .invalidHeader)
+        XCTAssertEqual(SASSupplyChain.validate("2.0,1!a,b,1"), .invalidHeader)
+        XCTAssertEqual(SASSupplyChain.validate("1.0,2!a,b,1"), .invalidCompleteFlag)
+        XCTAssertEqual(SASSupplyChain.validate("1.0,1"), .emptyChain)
+        XCTAssertEqual(SASSupplyChain.validate("1.0,1!a,b"), .missingField(node: 0))
+        XCTAssertEqual(SASSupplyChain.validate("1.0,1!a,,1"), .missingField(node: 0))
+        XCTAssertEqual(SASSupplyChain.validate("1.0,1!a,b,1!"), .missingField(node: 1))
+        XCTAssertEqual(SASSupplyChain.validate("1.0,1!a,b,2"), .invalidHpFlag(node: 0))
+        XCTAssertEqual(SASSupplyChain.validate("1.0,1!a,b,1,r,n,d,e,x"), .tooManyFields(node: 0))
+        XCTAssertEqual(SASSupplyChain.validate("1.0,1!a,b,1,%"), .invalidEncoding(node: 0))
+        XCTAssertEqual(SASSupplyChain.validate("1.0,1!a,b,1,%G1"), .invalidEncoding(node: 0))
+        XCTAssertEqual(SASSupplyChain.validate("1.0,1!a,b,1!a%FF,b,1"), .invalidEncoding(node: 1))
+        XCTAssertEqual(SASSupplyChain.validate("1.0,1!a%C0%80,b,1"), .invalidEncoding(node: 0))
+        XCTAssertEqual(SASSupplyChain.validate("1.0,1!a%ED%A0%80,b,1"), .invalidEncoding(node: 0))
+        XCTAssertEqual(SASSupplyChain.validate("1.0,1!a%E2%82,b,1"), .invalidEncoding(node: 0))
+        XCTAssertNil(SASSupplyChain.validate("1.0,1!a%e2%82%ac,b,1"))
+        XCTAssertThrowsError(try SASSupplyChain(string: "1.0,1!a%FF,b,1"))
+    }
+    
+    func testRandomChainsRoundTrip() throws {
+        var generator = SeededRandomNumberGenerator(seed: 42)
+        
+        for _ in 0..<Self.FUZZ_CASE_COUNT {
+            let chain = SASSupplyChain(isComplete: Bool.random(using: &generator), nodes: (0..<Int.random(in: 1...5, using: &generator)).map { _ in
+                SASSupplyChain.Node(
+                    asi: Self.randomFieldValue(using: &generator),
+                    sid: Self.randomFieldValue(using: &generator),
+                    hp: Bool.random(using: &generator),
+                    rid: Self.randomOptionalFieldValue(using: &generator),
+                    name: Self.randomOptionalFieldValue(using: &generator),
+                    domain: Self.randomOptionalFieldValue(using: &generator),
+                    ext: Self.randomOptionalFieldValue(using: &generator)
+                )
+            })
+            
+            let string = chain.stringValue
+            XCTAssertNil(SASSupplyChain.validate(string), string)
+            XCTAssertEqual(try SASSupplyChain(string: string), chain, string)
+        }
+    }
+    
+    func testMutatedStringsAgreeWithReference() {
+        var generator = SeededRandomNumberGenerator(seed: 7)
+        let seeds = [
+            "1.0,1!exchange1.com,1234,1,bid-request-1,Publisher%2C%20Inc.,publisher.com!exchange2.com,abcd,0,,,,%7B%22a%22%3A1%7D",
+            "1.0,0!a,b,1",
+            "1.0,1!%C3%A9,%F0%9F%99%82,0,r!x,y,1",
+        ]
+        var acceptedCount = 0
+        
+        for _ in 0..<Self.FUZZ_CASE_COUNT {
+            var scalars = Array(seeds.randomElement(using: &generator)!.unicodeScalars)
+            for _ in 0..<Int.random(in: 1...4, using: &generator) {
+                Self.mutate(&scalars, using: &generator)
+            }
+            var string = ""
+            string.unicodeScalars.append(contentsOf: scalars)
+            
+            // Must never crash, and must agree with the reference on both the validity and the decoded fields.
+            let error = SASSupplyChain.validate(string)
+            let referenceNodes = Self.referenceParse(string)
+            XCTAssertEqual(error == nil, referenceNodes != nil, "\(string): \(String(describing: error))")
+            
+            let chain = try? SASSupplyChain(string: string)
+            XCTAssertEqual(chain == nil, error != nil, string)
+            if let chain, let referenceNodes {
+                acceptedCount += 1
+                XCTAssertEqual(chain.nodes.map { node -> [String?] in [node.asi, node.sid, node.hp ? "1" : "0", node.rid, node.name, node.domain, node.ext] }, referenceNodes, string)
+                XCTAssertEqual(try? SASSupplyChain(string: chain.stringValue), chain, string)
+            }
+        }
+        
+        // The mutations must leave enough valid strings to compare the decoded fields.
+        XCTAssertGreaterThan(acceptedCount, Self.FUZZ_CASE_COUNT / 20)
+    }
+    
+    // MARK: - Private methods
+    
+    private static func randomFieldValue(using generator: inout SeededRandomNumberGenerator) -> String {
+        return String((0..<Int.random(in: 1...12, using: &generator)).map { _ in FIELD_CHARACTERS.randomElement(using: &generator)! })
+    }
+    
+    /// Returns nil or a non-empty value (an empty optional field is serialized as a missing one).
+    private static func randomOptionalFieldValue(using generator: inout SeededRandomNumberGenerator) -> String? {
+        return Bool.random(using: &generator) ? randomFieldValue(using: &generator) : nil
+    }
+    
+    private static func mutate(_ scalars: inout [Unicode.Scalar], using generator: inout SeededRandomNumberGenerator) {
+        let index = Int.random(in: 0...scalars.count, using: &generator)
+        switch Int.random(in: 0..<4, using: &generator) {
+        case 0:
+            scalars.insert(contentsOf: MUTATION_TOKENS.randomElement(using: &generator)!.unicodeScalars, at: index)
+        case 1:
+            scalars.removeSubrange(index..<min(index + Int.random(in: 1...3, using: &generator), scalars.count))
+        case 2:
+            scalars.removeSubrange(index..<scalars.count)
+        default:
+            let end = min(index + Int.random(in: 1...8, using: &generator), scalars.count)
+            let duplicatedScalars = Array(scalars[index..<end])
+            scalars.insert(contentsOf: duplicatedScalars, at: end)
+        }
+    }
+    
+    /**
+     Reference parsing, splitting the string instead of validating it in a single pass.
+     
+     @return The decoded fields of each node (seven per node, nil for the empty or missing ones), or nil if the string
+     is invalid.
+     */
+    private static func referenceParse(_ string: String) -> [[String?]]? {
+        let parts = string.components(separatedBy: "!")
+        guard parts.count >= 2, parts[0] == "1.0,0" || parts[0] == "1.0,1" else { return nil }
+        
+        var nodes = [[String?]]()
+        for part in parts.dropFirst() {
+            let fields = part.components(separatedBy: ",")
+            guard (3...7).contains(fields.count), !fields[0].isEmpty, !fields[1].isEmpty, fields[2] == "0" || fields[2] == "1" else {
+                return nil
+            }
+            var decodedFields = [String?]()
+            for field in fields {
+                guard let decodedField = referenceDecode(field) else { return nil }
+                decodedFields.append(decodedField.isEmpty ? nil : decodedField)
+            }
+            nodes.append(decodedFields + Array(repeating: nil, count: 7 - fields.count))
+        }
+        return nodes
+    }
+    
+    /// Decodes the percent-encoded sequences of a field, returning nil if a sequence or the decoded UTF-8 is invalid.
+    private static func referenceDecode(_ field: String) -> String? {
+        var bytes = [UInt8]()
+        var utf8 = Array(field.utf8)[...]
+        while let byte = utf8.popFirst() {
+            guard byte == UInt8(ascii: "%") else {
+                bytes.append(byte)
+                continue
+            }
+            let hexDigits = utf8.prefix(2)
+            guard hexDigits.count == 2, hexDigits.allSatisfy({ Character(Unicode.Scalar($0)).isHexDigit }),
+                  let escapedByte = UInt8(String(decoding: hexDigits, as: UTF8.self), radix: 16) else {
+                return nil
+            }
+            bytes.append(escapedByte)
+            utf8 = utf8.dropFirst(2)
+        }
+        
+        // The standard library decoder rejects overlong sequences, surrogates and truncated sequences.
+        var decoder = UTF8()
+        var iterator = bytes.makeIterator()
+        var scalars = String.UnicodeScalarView()
+        while true {
+            switch decoder.decode(&iterator) {
+            case .scalarValue(let scalar):
+                scalars.append(scalar)
+            case .emptyInput:
+                return String(scalars)
+            case .error:
+                return nil
+            }
+        }
+    }
+    
+}
@@ -0,0 +1,139 @@
+//
+//  SASVideoHeaderAdCellAsyncLoadingTests.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import UIKit
+import XCTest
+import SASDisplayKit
+@testable import VideoHeaderAdSample
+
+/**
+ Tests of the loads awaited with `SASVideoHeaderAdCell.loadAd(with:)`: cancelled by the awaiting task, by the ad cell
+ being closed, or started on a closed ad cell.
+ */
+final class SASVideoHeaderAdCellAsyncLoadingTests: XCTestCase {
+    
+    // MARK: - Constants
+    
+    private static let AD_PLACEMENT = SASAdPlacement(siteId: 507206, pageId: 1579908, formatId: 15048, keywordTargeting: "async")
+    
+    /// Slow ad calls, so a load is still in flight when it is cancelled.
+    private static let PROFILE = SASAdServerSimulator.Profile(latency: .constant(0.2))
+    
+    // MARK: - Tests
+    
+    @MainActor
+    func testCancelledTaskAbandonsLoad() async throws {
+        let server = SASAdServerSimulator(profile: Self.PROFILE)
+        let coalescer = SASAdLoadCoalescer(loader: server)
+        let delegate = SASDelegateRecorder()
+        let adCell = Self.makeAdCell(coalescer: coalescer, delegate: delegate)
+        
+        let task = Task { @MainActor in
+            try await adCell.loadAd(with: Self.AD_PLACEMENT)
+        }
+        try await Task.sleep(nanoseconds: 20_000_000)
+        task.cancel()
+        
+        // The awaiting task throws as soon as it is cancelled, without waiting for the ad call.
+        let result = await task.result
+        XCTAssertTrue(Self.error(of: result) is CancellationError)
+        XCTAssertEqual(coalescer.counters, SASAdLoadCoalescer.Counters(adCalls: 1, abandonedLoads: 1))
+        
+        // The abandoned ad call never reaches the ad cell delegate.
+        try await Task.sleep(nanoseconds: 300_000_000)
+        XCTAssertEqual(delegate.events, [])
+    }
+    
+    @MainActor
+    func testClosingAdCellCancelsLoad() async throws {
+        let server = SASAdServerSimulator(profile: Self.PROFILE)
+        let coalescer = SASAdLoadCoalescer(loader: server)
+        let delegate = SASDelegateRecorder()
+        let adCell = Self.makeAdCell(coalescer: coalescer, delegate: delegate)
+        
+        let task = Task { @MainActor in
+            try await adCell.loadAd(with: Self.AD_PLACEMENT)
+        }
+        try await Task.sleep(nanoseconds: 20_000_000)
+        adCell.closeAd()
+        
+        let result = await task.result
+        XCTAssertTrue(Self.error(of: result) is CancellationError)
+        XCTAssertEqual(coalescer.counters.abandonedLoads, 1)
+        XCTAssertEqual(delegate.events, [.close])
+    }
+    
+    @MainActor
+    func testLoadOnClosedAdCellFailsFast() async {
+        let server = SASAdServerSimulator(profile: Self.PROFILE)
+        let coalescer = SASAdLoadCoalescer(loader: server)
+        let delegate = SASDelegateRecorder()
+        let adCell = Self.makeAdCell(coalescer: coalescer, delegate: delegate)
+        adCell.closeAd()
+        
+        do {
+            _ = try await adCell.loadAd(with: Self.AD_PLACEMENT)
+            XCTFail("The load of a closed ad cell must throw")
+        } catch {
+            XCTAssertTrue(error is CancellationError)
+        }
+        
+        // The closed ad cell stays collapsed: no ad call is performed and the delegate is not notified again.
+        XCTAssertEqual(server.adCallCount, 0)
+        XCTAssertEqual(delegate.events, [.close])
+    }
+    
+    // MARK: - Private methods
+    
+    private static func makeAdCell(coalescer: SASAdLoadCoalescer, delegate: SASDelegateRecorder) -> SASVideoHeaderAdCell {
+        let nib = UINib(nibName: SASVideoHeaderAdCell.NIB_NAME, bundle: Bundle(for: SASVideoHeaderAdCell.self))
+        let adCell = nib.instantiate(withOwner: nil).compactMap { $0 as? SASVideoHeaderAdCell }.first!
+        adCell.prefetchCache = nil
+        adCell.retryPolicy = nil
+        adCell.loadCoalescer = coalescer
+        adCell.delegate = delegate
+        return adCell
+    }
+    
+    private static func error(of result: Result<SASAdInfo, any Error>) -> (any Error)? {
+        guard case .failure(let error) = result else { return nil }
+        return error
+    }
+    
+}
+
+/**
+ Ad cell delegate recording the calls it receives.
+ */
+private final class SASDelegateRecorder: NSObject, SASVideoHeaderAdCellDelegate {
+    
+    enum Event: Equatable {
+        case load
+        case failure
+        case click
+        case close
+    }
+    
+    private(set) var events = [Event]()
+    
+    func videoHeaderAdCell(_ videoHeaderAdCell: SASVideoHeaderAdCell, didLoadWith adInfo: SASAdInfo) {
+        events.append(.load)
+    }
+    
+    func videoHeaderAdCell(_ videoHeaderAdCell: SASVideoHeaderAdCell, didFailToLoad error: any Error) {
+        events.append(.failure)
+    }
+    
+    func videoHeaderAdCellClicked(_ videoHeaderAdCell: SASVideoHeaderAdCell) {
+        events.append(.click)
+    }
+    
+    func videoHeaderAdCellDidClose(_ videoHeaderAdCell: SASVideoHeaderAdCell) {
+        events.append(.close)
+    }
+    
+}
@@ -0,0 +1,159 @@
+//
+//  SASVideoHeaderAdCellBenchmarks.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import UIKit
+import XCTest
+@testable import VideoHeaderAdSample
+
+/**
+ Benchmarks of the layout work performed by the video header ad cell at the head of a long feed of variable-height
+ rows (see `SASFeedFixture`), when it is closed and when it is resized by the scroll.
+ 
+ Run them on a device with the Release configuration for meaningful durations.
+ */
+final class SASVideoHeaderAdCellBenchmarks: XCTestCase {
+    
+    // MARK: - Constants
+    
+    private static let ROW_COUNT = 10_000
+    
+    /// Number of frames of the scroll sweeping the shrink range of the ad (a 2 s scroll at 120 Hz).
+    private static let SCROLL_FRAME_COUNT = 240
+    
+    /// Distance (in points) scrolled down, then up, across the shrink range of the ad.
+    private static let SCROLL_DISTANCE: CGFloat = 200.0
+    
+    // MARK: - Types
+    
+    /// Per-frame work of a scroll sweeping the shrink range of the ad.
+    private struct ScrollResize {
+        /// Duration (in seconds) of the work of each frame: scroll event, layout pass and transaction commit.
+        var frameTimes = SASAdLoadGenerator.Percentiles([])
+        
+        /// Heights of the ad container laid out during the scroll.
+        var adContainerHeights = Set<CGFloat>()
+    }
+    
+    // MARK: - Close path
+    
+    func testCloseWithSelfSizingInvalidation() {
+        let measuredRows = measureClose(named: "close, self-sizing invalidation", selfSizingInvalidation: .enabled)
+        let fullUpdateMeasuredRows = measureCloseOnce(selfSizingInvalidation: .disabled)
+        
+        // Only the ad cell is invalidated: the visible feed rows measured again by a full update are not.
+        XCTAssertGreaterThan(fullUpdateMeasuredRows, 0)
+        XCTAssertLessThan(measuredRows, fullUpdateMeasuredRows)
+    }
+    
+    func testCloseWithFullTableViewUpdate() {
+        _ = measureClose(named: "close, beginUpdates / endUpdates", selfSizingInvalidation: .disabled)
+    }
+    
+    // MARK: - Scroll resize
+    
+    func testScrollResizeWithCompositing() {
+        let composited = measureScrollResize(named: "scroll resize, compositing", resizeMode: .compositing)
+        let constraints = performScrollResize(on: SASFeedFixture(rowCount: Self.ROW_COUNT) { $0.resizeMode = .constraints })
+        print("[benchmark] scroll resize frame time, compositing vs constraints: p50 \(Int(composited.frameTimes.p50 * 1_000_000.0)) µs vs \(Int(constraints.frameTimes.p50 * 1_000_000.0)) µs, p99 \(Int(composited.frameTimes.p99 * 1_000_000.0)) µs vs \(Int(constraints.frameTimes.p99 * 1_000_000.0)) µs")
+        
+        // The ad container keeps its maximum size: the banner subtree is never laid out again while scrolling.
+        XCTAssertEqual(composited.adContainerHeights.count, 1)
+        XCTAssertGreaterThan(constraints.adContainerHeights.count, 1)
+    }
+    
+    func testScrollResizeWithConstraints() {
+        let constraints = measureScrollResize(named: "scroll resize, constraints", resizeMode: .constraints)
+        
+        // The ad container is resized on the scroll events.
+        XCTAssertGreaterThan(constraints.adContainerHeights.count, 1)
+    }
+    
+    // MARK: - Private methods
+    
+    /**
+     Measures the duration of `closeAd()` (including the layout pass it triggers) on a new feed for each iteration.
+     
+     @return The highest number of feed rows measured again by the table view during a close.
+     */
+    private func measureClose(named name: String, selfSizingInvalidation: UITableView.SelfSizingInvalidation) -> Int {
+        var measuredRows = 0
+        
+        // Building and laying out the feed is not measured.
+        let options = XCTMeasureOptions()
+        options.invocationOptions = [.manuallyStart, .manuallyStop]
+        measure(metrics: [XCTClockMetric()], options: options) {
+            let feed = SASFeedFixture(rowCount: Self.ROW_COUNT, selfSizingInvalidation: selfSizingInvalidation)
+            SASFeedFixture.FeedCell.measurementCount = 0
+            
+            startMeasuring()
+            feed.adCell.closeAd()
+            feed.tableView.layoutIfNeeded()
+            stopMeasuring()
+            
+            measuredRows = max(measuredRows, SASFeedFixture.FeedCell.measurementCount)
+            XCTAssertEqual(feed.tableView.rectForRow(at: IndexPath(row: 0, section: 0)).height, 0.0, accuracy: 1.0)
+        }
+        
+        print("[benchmark] \(name) (\(Self.ROW_COUNT) rows): \(measuredRows) rows measured again")
+        return measuredRows
+    }
+    
+    /**
+     Measures the duration of a scroll sweeping the shrink range of the ad, on a new feed for each iteration.
+     
+     @return The per-frame work of the last scroll.
+     */
+    private func measureScrollResize(named name: String, resizeMode: SASVideoHeaderAdCell.ResizeMode) -> ScrollResize {
+        var scrollResize = ScrollResize()
+        
+        // Building and laying out the feed is not measured.
+        let options = XCTMeasureOptions()
+        options.invocationOptions = [.manuallyStart, .manuallyStop]
+        measure(metrics: [XCTClockMetric()], options: options) {
+            let feed = SASFeedFixture(rowCount: Self.ROW_COUNT) { $0.resizeMode = resizeMode }
+            
+            startMeasuring()
+            scrollResize = performScrollResize(on: feed)
+            stopMeasuring()
+        }
+        
+        print("[benchmark] \(name) (\(Self.SCROLL_FRAME_COUNT) frames): frame time p50 \(Int(scrollResize.frameTimes.p50 * 1_000_000.0)) µs, p99 \(Int(scrollResize.frameTimes.p99 * 1_000_000.0)) µs")
+        return scrollResize
+    }
+    
+    private func performScrollResize(on feed: SASFeedFixture) -> ScrollResize {
+        var frameTimes = [TimeInterval]()
+        frameTimes.reserveCapacity(Self.SCROLL_FRAME_COUNT)
+        var adContainerHeights = Set<CGFloat>()
+        
+        for frame in 0..<Self.SCROLL_FRAME_COUNT {
+            // The feed is scrolled down, then back up.
+            let progress = 1.0 - abs(1.0 - 2.0 * CGFloat(frame) / CGFloat(Self.SCROLL_FRAME_COUNT - 1))
+            let offset = CGPoint(x: 0.0, y: progress * Self.SCROLL_DISTANCE)
+            
+            // The work of a frame: the scroll event, the layout pass it triggers and the commit of the transaction.
+            let start = CACurrentMediaTime()
+            feed.adCell.scrollViewDidScroll(offset: offset)
+            feed.window.layoutIfNeeded()
+            CATransaction.flush()
+            frameTimes.append(CACurrentMediaTime() - start)
+            
+            adContainerHeights.insert(feed.adCell.adContainerView.bounds.height)
+        }
+        
+        return ScrollResize(frameTimes: SASAdLoadGenerator.Percentiles(frameTimes), adContainerHeights: adContainerHeights)
+    }
+    
+    private func measureCloseOnce(selfSizingInvalidation: UITableView.SelfSizingInvalidation) -> Int {
+        let feed = SASFeedFixture(rowCount: Self.ROW_COUNT, selfSizingInvalidation: selfSizingInvalidation)
+        SASFeedFixture.FeedCell.measurementCount = 0
+        feed.adCell.closeAd()
+        feed.tableView.layoutIfNeeded()
+        return SASFeedFixture.FeedCell.measurementCount
+    }
+    
+}
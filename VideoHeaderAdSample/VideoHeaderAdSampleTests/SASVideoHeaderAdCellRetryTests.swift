@@ -0,0 +1,166 @@
+//
+//  SASVideoHeaderAdCellRetryTests.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import UIKit
+import XCTest
+import SASDisplayKit
+@testable import VideoHeaderAdSample
+
+/**
+ Tests of the retries of the ad cell, loading its ads through a coalescer from the ad server simulator.
+ 
+ Latencies and backoff delays are scaled down (a few milliseconds instead of a few hundred), so the loads run in real
+ time quickly.
+ */
+final class SASVideoHeaderAdCellRetryTests: XCTestCase {
+    
+    // MARK: - Constants
+    
+    private static let AD_PLACEMENT = SASAdPlacement(siteId: 507206, pageId: 1579908, formatId: 15048, keywordTargeting: "retry")
+    
+    /// Number of loads of the error burst test.
+    private static let LOAD_COUNT = 200
+    
+    /// Fast ad calls, failing by bursts of 2 consecutive ad calls.
+    private static let BURST_PROFILE = SASAdServerSimulator.Profile(latency: .constant(0.002), errorBurstRate: 0.05, errorBurstLength: 2)
+    
+    /// The default backoffs, scaled down by 100.
+    private static let CONFIGURATION = SASAdRetryPolicy.Configuration(
+        backoffs: [
+            .timeout: SASAdRetryPolicy.Backoff(maximumRetries: 2, initialDelay: 0.0025, maximumDelay: 0.02),
+            .network: SASAdRetryPolicy.Backoff(maximumRetries: 3, initialDelay: 0.005, maximumDelay: 0.04),
+            .other: .never,
+        ],
+        displayDeadline: 0.05,
+        minimumAttemptDuration: 0.01,
+        budgetRatio: 0.2,
+        maximumBurst: 10.0
+    )
+    
+    // MARK: - Tests
+    
+    @MainActor
+    func testRetriesRecoverFromErrorBursts() async {
+        let unretriedServer = SASAdServerSimulator(profile: Self.BURST_PROFILE)
+        let unretried = await load(count: Self.LOAD_COUNT, from: unretriedServer, retryPolicy: nil)
+        
+        let retriedServer = SASAdServerSimulator(profile: Self.BURST_PROFILE)
+        let retryPolicy = SASAdRetryPolicy(configuration: Self.CONFIGURATION)
+        let retried = await load(count: Self.LOAD_COUNT, from: retriedServer, retryPolicy: retryPolicy)
+        
+        let unretriedFillRate = Self.fillRate(of: unretried)
+        let retriedFillRate = Self.fillRate(of: retried)
+        let counters = retryPolicy.counters
+        print("[benchmark] retries (\(Self.LOAD_COUNT) loads with error bursts): fill rate \(retriedFillRate) vs \(unretriedFillRate) — \(counters.retries) retries, \(counters.giveUps) give-ups, \(counters.deadlineExceeded) past the deadline, \(counters.budgetDenials) denied by the budget")
+        
+        // The loads hit by a burst fail without retry, and recover once the burst is over with retries.
+        XCTAssertLessThan(unretriedFillRate, 1.0)
+        XCTAssertGreaterThan(retriedFillRate, unretriedFillRate)
+        XCTAssertGreaterThan(counters.retries, 0)
+        
+        // Each retry performs exactly one extra ad call, within the budget.
+        XCTAssertEqual(unretriedServer.adCallCount, Self.LOAD_COUNT)
+        XCTAssertEqual(retriedServer.adCallCount, Self.LOAD_COUNT + counters.retries)
+        XCTAssertLessThanOrEqual(Double(counters.retries), Self.CONFIGURATION.maximumBurst + Self.CONFIGURATION.budgetRatio * Double(Self.LOAD_COUNT))
+    }
+    
+    @MainActor
+    func testRetriesAreExhaustedByLongBursts() async {
+        let server = SASAdServerSimulator(profile: SASAdServerSimulator.Profile(latency: .constant(0.002), errorRate: 1.0))
+        var configuration = Self.CONFIGURATION
+        configuration.displayDeadline = 1.0
+        let retryPolicy = SASAdRetryPolicy(configuration: configuration)
+        
+        let results = await load(count: 1, from: server, retryPolicy: retryPolicy)
+        
+        // The network error is reported once the 3 retries have failed.
+        XCTAssertEqual((Self.failure(of: results[0]))?.domain, NSURLErrorDomain)
+        XCTAssertEqual(server.adCallCount, 4)
+        XCTAssertEqual(retryPolicy.counters, SASAdRetryPolicy.Counters(retries: 3, giveUps: 1))
+    }
+    
+    @MainActor
+    func testRetriesStopAtDisplayDeadline() async {
+        // Each ad call lasts 50 ms: the second retry could not return before the 100 ms display deadline.
+        let server = SASAdServerSimulator(profile: SASAdServerSimulator.Profile(latency: .constant(0.05), errorRate: 1.0))
+        var configuration = Self.CONFIGURATION
+        configuration.displayDeadline = 0.1
+        let retryPolicy = SASAdRetryPolicy(configuration: configuration)
+        
+        let results = await load(count: 1, from: server, retryPolicy: retryPolicy)
+        
+        XCTAssertNotNil(Self.failure(of: results[0]))
+        XCTAssertEqual(retryPolicy.counters.retries, 1)
+        XCTAssertEqual(retryPolicy.counters.deadlineExceeded, 1)
+        XCTAssertEqual(server.adCallCount, 2)
+    }
+    
+    @MainActor
+    func testUnclassifiedErrorIsNotRetried() async {
+        let server = SASAdServerSimulator(profile: SASAdServerSimulator.Profile(latency: .constant(0.002), noFillRate: 1.0))
+        let retryPolicy = SASAdRetryPolicy(configuration: Self.CONFIGURATION)
+        
+        let results = await load(count: 1, from: server, retryPolicy: retryPolicy)
+        
+        XCTAssertEqual((Self.failure(of: results[0]))?.domain, SASAdServerSimulator.ERROR_DOMAIN)
+        XCTAssertEqual(SASAdRetryPolicy.errorClass(of: Self.failure(of: results[0])!), .other)
+        XCTAssertEqual(server.adCallCount, 1)
+        XCTAssertEqual(retryPolicy.counters, SASAdRetryPolicy.Counters(giveUps: 1))
+    }
+    
+    func testOnlyTimeoutsAndNetworkErrorsAreClassified() {
+        XCTAssertEqual(SASAdRetryPolicy.errorClass(of: SASAdCallTimeoutError(timeout: 1.0)), .timeout)
+        XCTAssertEqual(SASAdRetryPolicy.errorClass(of: NSError(domain: NSURLErrorDomain, code: NSURLErrorTimedOut)), .timeout)
+        XCTAssertEqual(SASAdRetryPolicy.errorClass(of: NSError(domain: NSURLErrorDomain, code: NSURLErrorNotConnectedToInternet)), .network)
+        
+        // The SDK does not document its errors: none of them is mistaken for a timeout.
+        XCTAssertEqual(SASAdRetryPolicy.errorClass(of: NSError(domain: SASAdErrors, code: 1)), .other)
+        XCTAssertEqual(SASAdRetryPolicy.errorClass(of: CancellationError()), .other)
+    }
+    
+    // MARK: - Private methods
+    
+    /**
+     Loads ads one after the other, each one in a new ad cell (an ad cell failing to load an ad is closed).
+     
+     @return The result of each load.
+     */
+    @MainActor
+    private func load(count: Int, from server: SASAdServerSimulator, retryPolicy: SASAdRetryPolicy?) async -> [Result<SASAdInfo, any Error>] {
+        let coalescer = SASAdLoadCoalescer(loader: server)
+        var results = [Result<SASAdInfo, any Error>]()
+        for _ in 0..<count {
+            let adCell = Self.makeAdCell(coalescer: coalescer, retryPolicy: retryPolicy)
+            do {
+                results.append(.success(try await adCell.loadAd(with: Self.AD_PLACEMENT)))
+            } catch {
+                results.append(.failure(error))
+            }
+        }
+        return results
+    }
+    
+    private static func makeAdCell(coalescer: SASAdLoadCoalescer, retryPolicy: SASAdRetryPolicy?) -> SASVideoHeaderAdCell {
+        let nib = UINib(nibName: SASVideoHeaderAdCell.NIB_NAME, bundle: Bundle(for: SASVideoHeaderAdCell.self))
+        let adCell = nib.instantiate(withOwner: nil).compactMap { $0 as? SASVideoHeaderAdCell }.first!
+        adCell.prefetchCache = nil
+        adCell.loadCoalescer = coalescer
+        adCell.retryPolicy = retryPolicy
+        return adCell
+    }
+    
+    private static func fillRate(of results: [Result<SASAdInfo, any Error>]) -> Double {
+        let loadedCount = results.filter { if case .success = $0 { return true } else { return false } }.count
+        return Double(loadedCount) / Double(results.count)
+    }
+    
+    private static func failure(of result: Result<SASAdInfo, any Error>) -> NSError? {
+        guard case .failure(let error) = result else { return nil }
+        return error as NSError
+    }
+    
+}
@@ -0,0 +1,256 @@
+//
+//  SASVideoHeaderAdLayoutTests.swift
+//  VideoHeaderAdSample
+//
+//  Created by Equativ on 17/10/2026.
+//
+
+import Foundation
+import XCTest
+#if canImport(VideoHeaderAdCore)
+@testable import VideoHeaderAdCore
+#else
+@testable import VideoHeaderAdSample
+#endif
+
+/**
+ Replays scroll traces through the geometry engine of the video header ad and checks the transitions it emits.
+ */
+final class SASVideoHeaderAdLayoutTests: XCTestCase {
+    
+    // MARK: - Constants
+    
+    private static let WIDTH: CGFloat = 390.0
+    private static let MAX_RATIO: CGFloat = 16.0 / 9.0
+    private static let MIN_RATIO: CGFloat = 32.0 / 9.0
+    private static let EVENT_INTERVAL: TimeInterval = 1.0 / 120.0
+    
+    // MARK: - Properties
+    
+    private var layout = SASVideoHeaderAdLayout(maxRatio: SASVideoHeaderAdLayoutTests.MAX_RATIO, minRatio: SASVideoHeaderAdLayoutTests.MIN_RATIO)
+    
+    /// Offset from which the banner is stuck.
+    private var threshold: CGFloat {
+        return layout.maxSize(width: Self.WIDTH) - layout.minSize(width: Self.WIDTH)
+    }
+    
+    private var minSize: CGFloat {
+        return layout.minSize(width: Self.WIDTH)
+    }
+    
+    // MARK: - Hysteresis
+    
+    func testSlowDragAroundThresholdFlapsWithoutHysteresis() {
+        let transitions = replay(slowDragAroundThreshold(amplitude: 4.0, cycles: 5))
+        
+        // Each crossing of the threshold is a transition: 5 sticks and 5 unsticks.
+        XCTAssertEqual(transitions, alternating(count: 10))
+        XCTAssertEqual(layout.counters.transitions, 10)
+    }
+    
+    func testHysteresisPreventsFlappingAroundThreshold() {
+        layout.hysteresis = 8.0
+        
+        let transitions = replay(slowDragAroundThreshold(amplitude: 4.0, cycles: 5))
+        
+        // The drag never goes back over the hysteresis band, so the banner is stuck once and stays stuck.
+        XCTAssertEqual(transitions, [.stick])
+        XCTAssertTrue(layout.isStuck)
+    }
+    
+    func testHysteresisStillUnsticksOutsideOfBand() {
+        layout.hysteresis = 8.0
+        
+        let transitions = replay(slowDragAroundThreshold(amplitude: 12.0, cycles: 3))
+        
+        XCTAssertEqual(transitions, alternating(count: 6))
+    }
+    
+    // MARK: - Minimum state duration
+    
+    func testMinimumStateDurationDelaysTransitions() {
+        layout.minimumStateDuration = 1.0
+        
+        let transitions = replay(slowDragAroundThreshold(amplitude: 4.0, cycles: 2))
+        
+        // The drag ends before the minimum state duration has elapsed since the first stick: every unstick is delayed.
+        XCTAssertEqual(transitions, [.stick])
+        XCTAssertGreaterThan(layout.counters.delayedTransitions, 0)
+    }
+    
+    func testDelayedTransitionIsEmittedWhenReplayedAtPendingTimestamp() {
+        layout.minimumStateDuration = 1.0
+        
+        XCTAssertEqual(scroll(to: threshold + 10.0, at: 0.1).transition, .stick)
+        
+        let delayed = scroll(to: threshold - 10.0, at: 0.2)
+        XCTAssertEqual(delayed.transition, .none)
+        XCTAssertEqual(layout.pendingTransition, .unstick)
+        XCTAssertEqual(layout.counters.delayedTransitions, 1)
+        
+        guard let pendingTransitionTimestamp = delayed.pendingTransitionTimestamp else {
+            return XCTFail("The delayed transition must expose the timestamp from which it can be emitted")
+        }
+        XCTAssertEqual(pendingTransitionTimestamp, 1.1, accuracy: 1e-9)
+        
+        // The ad cell replays the last offset once the minimum state duration has elapsed.
+        let replayed = scroll(to: layout.lastOffset, at: pendingTransitionTimestamp)
+        XCTAssertEqual(replayed.transition, .unstick)
+        XCTAssertNil(replayed.pendingTransitionTimestamp)
+        XCTAssertEqual(layout.pendingTransition, .none)
+        XCTAssertFalse(layout.isStuck)
+    }
+    
+    func testDelayedStickKeepsBannerInlineAtMinimumSize() {
+        layout.minimumStateDuration = 1.0
+        
+        XCTAssertEqual(scroll(to: threshold + 10.0, at: 0.0).transition, .stick)
+        XCTAssertEqual(scroll(to: threshold - 50.0, at: 2.0).transition, .unstick)
+        
+        let delayed = scroll(to: threshold + 40.0, at: 2.1)
+        XCTAssertEqual(delayed.transition, .none)
+        XCTAssertEqual(layout.pendingTransition, .stick)
+        XCTAssertNotNil(delayed.pendingTransitionTimestamp)
+        
+        // The banner must not shrink below its minimum size while its stick is delayed.
+        guard let adContainerHeight = delayed.adContainerHeight else {
+            return XCTFail("A delayed stick must emit the height of the inline banner")
+        }
+        XCTAssertEqual(adContainerHeight, minSize, accuracy: 1e-9)
+        
+        let replayed = scroll(to: layout.lastOffset, at: delayed.pendingTransitionTimestamp ?? 0.0)
+        XCTAssertEqual(replayed.transition, .stick)
+        XCTAssertEqual(replayed.stuckHeight, minSize)
+    }
+    
+    func testPendingTransitionIsDroppedWhenNoLongerNeeded() {
+        layout.minimumStateDuration = 1.0
+        
+        XCTAssertEqual(scroll(to: threshold + 10.0, at: 0.1).transition, .stick)
+        XCTAssertEqual(layout.pendingTransition, .none)
+        XCTAssertNotNil(scroll(to: threshold - 10.0, at: 0.2).pendingTransitionTimestamp)
+        
+        // Scrolling back before the pending timestamp cancels the pending unstick.
+        let commands = scroll(to: threshold + 10.0, at: 0.3)
+        XCTAssertEqual(commands.transition, .none)
+        XCTAssertNil(commands.pendingTransitionTimestamp)
+        XCTAssertEqual(layout.pendingTransition, .none)
+        XCTAssertTrue(layout.isStuck)
+    }
+    
+    func testCloseDropsPendingTransition() {
+        layout.minimumStateDuration = 1.0
+        
+        _ = scroll(to: threshold + 10.0, at: 0.1)
+        _ = scroll(to: threshold - 10.0, at: 0.2)
+        XCTAssertEqual(layout.pendingTransition, .unstick)
+        
+        layout.close()
+        
+        XCTAssertEqual(layout.pendingTransition, .none)
+        XCTAssertEqual(scroll(to: threshold - 10.0, at: 2.0), SASVideoHeaderAdLayout.Commands.none)
+    }
+    
+    // MARK: - Change threshold
+    
+    func testUnchangedHeightsAreNotEmittedAgain() {
+        let first = scroll(to: 10.0, at: 0.0)
+        XCTAssertEqual(first.adContainerHeight, layout.maxSize(width: Self.WIDTH) - 10.0)
+        XCTAssertEqual(first.paddingHeight, layout.maxSize(width: Self.WIDTH))
+        
+        XCTAssertEqual(scroll(to: 10.0, at: 0.1), SASVideoHeaderAdLayout.Commands.none)
+        XCTAssertEqual(layout.counters.constraintWrites, 2)
+        XCTAssertEqual(layout.counters.skippedWrites, 2)
+    }
+    
+    func testSubThresholdChangeIsSkipped() {
+        layout.changeThreshold = 0.5
+        
+        _ = scroll(to: 10.0, at: 0.0)
+        
+        // The change is compared to the last emitted height, so small steps add up until they exceed the threshold.
+        XCTAssertNil(scroll(to: 10.3, at: 0.1).adContainerHeight)
+        XCTAssertEqual(scroll(to: 10.8, at: 0.2).adContainerHeight, layout.maxSize(width: Self.WIDTH) - 10.8)
+        XCTAssertEqual(layout.counters.adContainerHeightWrites, 2)
+        XCTAssertEqual(layout.counters.paddingHeightWrites, 1)
+        XCTAssertEqual(layout.counters.skippedWrites, 3)
+    }
+    
+    func testNilThresholdEmitsEveryTime() {
+        layout.changeThreshold = nil
+        
+        for index in 0..<3 {
+            let commands = scroll(to: 10.0, at: TimeInterval(index) * Self.EVENT_INTERVAL)
+            XCTAssertEqual(commands.adContainerHeight, layout.maxSize(width: Self.WIDTH) - 10.0)
+            XCTAssertEqual(commands.paddingHeight, layout.maxSize(width: Self.WIDTH))
+        }
+        XCTAssertEqual(layout.counters.constraintWrites, 6)
+        XCTAssertEqual(layout.counters.skippedWrites, 0)
+    }
+    
+    func testInvalidatedHeightsAreEmittedAgain() {
+        _ = scroll(to: 10.0, at: 0.0)
+        
+        layout.invalidateAppliedHeights()
+        
+        let commands = scroll(to: 10.0, at: 0.1)
+        XCTAssertEqual(commands.adContainerHeight, layout.maxSize(width: Self.WIDTH) - 10.0)
+        XCTAssertEqual(commands.paddingHeight, layout.maxSize(width: Self.WIDTH))
+    }
+    
+    func testRatioUpdateEmitsHeightsAgain() {
+        _ = scroll(to: 10.0, at: 0.0)
+        
+        layout.updateRatios(maxRatio: 2.0, minRatio: 4.0)
+        
+        let commands = scroll(to: 10.0, at: 0.1)
+        XCTAssertEqual(commands.adContainerHeight, Self.WIDTH / 2.0 - 10.0)
+        XCTAssertEqual(commands.paddingHeight, Self.WIDTH / 2.0)
+    }
+    
+    func testRatioUpdateEmitsStuckHeightAgain() {
+        XCTAssertEqual(scroll(to: threshold + 10.0, at: 0.0).transition, .stick)
+        XCTAssertNil(scroll(to: threshold + 10.0, at: 0.1).stuckHeight)
+        
+        layout.updateRatios(maxRatio: 2.0, minRatio: 4.0)
+        
+        // The banner stays stuck, with the minimum size of the new ratio.
+        let commands = scroll(to: threshold + 10.0, at: 0.2)
+        XCTAssertEqual(commands.transition, .none)
+        XCTAssertEqual(commands.stuckHeight, Self.WIDTH / 4.0)
+    }
+    
+    // MARK: - Private methods
+    
+    private func scroll(to offset: CGFloat, at timestamp: TimeInterval) -> SASVideoHeaderAdLayout.Commands {
+        return layout.scrollViewDidScroll(width: Self.WIDTH, offset: offset, timestamp: timestamp)
+    }
+    
+    /// Replays a trace of offsets sampled at 120 Hz and returns the transitions emitted.
+    private func replay(_ offsets: [CGFloat]) -> [SASVideoHeaderAdLayout.Transition] {
+        var transitions = [SASVideoHeaderAdLayout.Transition]()
+        for (index, offset) in offsets.enumerated() {
+            let commands = scroll(to: offset, at: TimeInterval(index) * Self.EVENT_INTERVAL)
+            if commands.transition != .none {
+                transitions.append(commands.transition)
+            }
+        }
+        return transitions
+    }
+    
+    /// Slow drag oscillating around the stick threshold (0.5 s per cycle).
+    private func slowDragAroundThreshold(amplitude: CGFloat, cycles: Int) -> [CGFloat] {
+        let threshold = self.threshold
+        let eventsPerCycle = 60
+        return (0..<(cycles * eventsPerCycle)).map { index in
+            let phase = Double(index) / Double(eventsPerCycle) * 2.0 * .pi
+            // The offset starts below the threshold (banner inline) then crosses it twice per cycle.
+            return threshold - amplitude * CGFloat(cos(phase))
+        }
+    }
+    
+    private func alternating(count: Int) -> [SASVideoHeaderAdLayout.Transition] {
+        return (0..<count).map { $0 % 2 == 0 ? .stick : .unstick }
+    }
+    
+}
@@ -6,6 +6,7 @@
 //
 
 import UIKit
+import SASDisplayKit
 
 struct MenuItem {
     let title: String
@@ -23,6 +24,17 @@ class MainViewController: UITableViewController {
         MenuItem(title: "Video Header Ad", segue: "videoHeaderAdViewControllerSegue")
     ]
     
+    // MARK: - View controller lifecycle
+    
+    override func viewWillAppear(_ animated: Bool) {
+        super.viewWillAppear(animated)
+        
+        // The video header ad is prefetched each time the menu is about to be displayed (including when the user
+        // comes back from the sample, whose ad cell has taken the previous one), so it is ready to be displayed
+        // when the user opens the sample. The prefetch is ignored if an ad is already loading or ready.
+        SASAdPrefetchCache.shared.prefetchAd(with: VideoHeaderAdViewController.AD_PLACEMENT)
+    }
+    
     // MARK: - Table view delegate & data source
     
     override func tableView(_ tableView: UITableView, numberOfRowsInSection section: Int) -> Int {
@@ -17,7 +17,7 @@ import SASDisplayKit
  Note that this particular integration requires the use of a simple `UIViewController`, it
  will not work with a `UITableViewController`.
  */
-class VideoHeaderAdViewController: UIViewController, UITableViewDelegate, UITableViewDataSource, UIScrollViewDelegate, SASVideoHeaderAdCellDelegate {
+class VideoHeaderAdViewController: UIViewController, UITableViewDelegate, UITableViewDataSource, SASVideoHeaderAdCellDelegate {
     
     // MARK: - Properties
     
@@ -30,7 +30,7 @@ class VideoHeaderAdViewController: UIViewController, UITableViewDelegate, UITabl
     // @warning Check your placements carefully: the ad on this placement must use the Video Header-Ad dedicated
     // template otherwise the ad might not be displayed properly (typically the ad will not have a close button
     // or might expand when clicked for videos).
-    private let adPlacement = SASAdPlacement(siteId: 507206, pageId: 1579908, formatId: 15048, keywordTargeting: "header01")
+    static let AD_PLACEMENT = SASAdPlacement(siteId: 507206, pageId: 1579908, formatId: 15048, keywordTargeting: "header01")
     
     private lazy var headerAdCell = {
         tableView.dequeueReusableCell(withIdentifier: SASVideoHeaderAdCell.CELL_REUSE_IDENTIFIER)! as! SASVideoHeaderAdCell
@@ -51,21 +51,22 @@ class VideoHeaderAdViewController: UIViewController, UITableViewDelegate, UITabl
         loadBannerView()
     }
     
+    override func viewDidDisappear(_ animated: Bool) {
+        super.viewDidDisappear(animated)
+        
+        // The latencies of the ad lifecycle (ad call, load, first frame, stick, click and close) recorded by the
+        // ad cell are dumped as JSON, so they can be analyzed offline.
+        if let json = try? SASAdLifecycleTracer.shared.jsonData() {
+            NSLog("Video Header-Ad lifecycle latencies:\n\(String(decoding: json, as: UTF8.self))")
+        }
+    }
+    
     @objc func refreshControlAction() {
         refreshControl.endRefreshing()
         
         // This refresh control does nothing, it is just here to show that we can use a pull to refresh while having a SASVideoHeaderAd…
     }
     
-    // MARK: - UIScrollViewDelegate methods
-    
-    func scrollViewDidScroll(_ scrollView: UIScrollView) {
-        // The video header cell must know the current scroll state of the table view:
-        // It is forwarded once during the ad cell setup and will then be forwarded for each
-        // scroll event.
-        headerAdCell.scrollViewDidScroll(offset: scrollView.contentOffset)
-    }
-    
     // MARK: - Ad logic
     
     func setupHeaderAdCell() {
@@ -87,15 +88,23 @@ class VideoHeaderAdViewController: UIViewController, UITableViewDelegate, UITabl
         // this is the controller the SDK will use if the ad needs to be expanded in a modal state
         headerAdCell.modalParentViewController = self
         
+        // Tracing the lifecycle of the ad (the latencies are dumped when the view controller disappears)
+        headerAdCell.lifecycleTracer = SASAdLifecycleTracer.shared
+        
         // The video header cell must know the current scroll state of the table view:
-        // It is forwarded once during the ad cell setup and will then be forwarded for each
-        // scroll event.
+        // It is forwarded once during the ad cell setup, then the ad cell will observe the scroll events
+        // by itself as soon as it is displayed in the table view.
+        //
+        // Note that you can also leave `handlesScrollEventsAutomatically` disabled and forward each scroll
+        // event from your `UIScrollViewDelegate` by calling `scrollViewDidScroll(offset:)` on the ad cell.
+        headerAdCell.handlesScrollEventsAutomatically = true
         headerAdCell.scrollViewDidScroll(offset: tableView.contentOffset)
     }
     
     func loadBannerView() {
-        // Delegating the ad loading to the ad cell
-        headerAdCell.loadAd(with: adPlacement)
+        // Delegating the ad loading to the ad cell: if the ad has been prefetched (see `MainViewController`),
+        // the ad cell will display it without performing a new ad call.
+        headerAdCell.loadAd(with: VideoHeaderAdViewController.AD_PLACEMENT)
     }
     
     // MARK: - Table view delegate & data source
@@ -109,14 +118,14 @@ class VideoHeaderAdViewController: UIViewController, UITableViewDelegate, UITabl
             // The video header ad effect works by always setting the header ad cell as the first cell
             // of your table view.
             //
-            // The cell will automatically change its size as the user scroll (by calling `scrollViewDidScroll`
-            // as seen in the previous methods) and will automatically be removed from its table view and
+            // The cell will automatically change its size as the user scroll (by observing the scroll events
+            // of the table view as seen in the previous methods) and will automatically be removed from its table view and
             // stuck over it when its size reach the minimum ratio (check the `SASVideoHeaderAdCell`
             // class for more info).
             //
             // Note that you don't need to handle the case where no ad can be found or where the ad loading
-            // fails for any reason: in this case the ad cell will automatically collapse and will not be
-            // visible by the user anymore.
+            // fails for any reason: in this case the ad cell will automatically collapse (after retrying the load
+            // if the failure is transient) and will not be visible by the user anymore.
             return headerAdCell
         } else {
             let cell = tableView.dequeueReusableCell(withIdentifier: "ContentCell")!